@@ -60,6 +60,7 @@
 #define configQUEUE_REGISTRY_SIZE 8
 #define configUSE_QUEUE_SETS 1
 #define configUSE_TIME_SLICING 1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 2 // 0: FFT helper (fft_helper.c), 1: frame events (CAM_FRAME_NOTIFY_INDEX)
 #define configUSE_NEWLIB_REENTRANT 0
 // todo need this for lwip FreeRTOS sys_arch to compile
 #define configENABLE_BACKWARD_COMPATIBILITY 1
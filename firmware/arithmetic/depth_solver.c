@@ -0,0 +1,742 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "hardware/timer.h"
+#include "fc_solver.h"
+#include "fft_mixed.h"
+#include "depth_solver.h"
+
+#define MG_MAX_LEVELS (10)
+#define DS_MAX_W (FFT_MIXED_MAX) // MG の幅の上限 (DCT は FFT_PLAN_MAX)
+
+// DCT/MG 共通の1行の作業領域 (SRAM)
+static float ds_pair[2][DS_MAX_W]; // DCT: 退避した k1 行目と -k1 行目, MG: 残差の2行
+static float ds_row[DS_MAX_W];
+static uint8_t ds_done[FFT_PLAN_MAX]; // DCT: 行の並べ替えの済み印
+
+// 発散 f = div(g), g = (-2p, 2q) の i 行目 (Neumann 境界)
+// 半画素の位置の勾配は隣の2画素の平均. f の総和は 0 (ポアソン方程式の解がある)
+static void ds_div_row(int height, int width, float **p, float **q, int i, float *f)
+{
+    const float *pr = p[i];
+
+    for (int j = 0; j < width; j++)
+    {
+        float g = 0.0f;
+        if (j < width - 1)
+            g -= pr[j] + pr[j + 1];
+        if (j > 0)
+            g += pr[j - 1] + pr[j];
+        if (i < height - 1)
+            g += q[i][j] + q[i + 1][j];
+        if (i > 0)
+            g -= q[i - 1][j] + q[i][j];
+        f[j] = g;
+    }
+}
+
+// ---- FC ----
+
+static bool fc_init(int height, int width)
+{
+    // cam.c が確保済みなら使い回す (init_fc_packed() は1回だけ)
+    return fc_packed_view(0) != NULL || init_fc_packed(height, width);
+}
+
+static uint32_t fc_mem(int height, int width)
+{
+    // 複素数作業領域 + 伝達関数の表 + u, v, 1行 + 行ポインタ
+    return sizeof(float) * (height * width * 2 + (height / 2 + 1) * width * 2 + width * 2 + height) +
+           sizeof(float *) * height * 3;
+}
+
+// ---- DCT (Simchony) ----
+//
+// Neumann 境界の離散ラプラシアンは DCT-II で対角化される (固有値 2cos(pi k1/n1) + 2cos(pi k2/n2) - 4).
+// 2次元 DCT-II は, 偶数番目を前から, 奇数番目を後ろから並べた v の DFT V から
+//   X(k1, k2) = 1/2 Re[W1(k1) (W2(k2) V(k1, k2) + conj W2(k2) V(k1, -k2))],  W(k) = exp(-i pi k / 2n)
+// 逆変換 (DCT-III) は
+//   V(k1, k2) = conj(W1 W2) [(X(k1, k2) - X(-k1, -k2)) - i (X(-k1, k2) + X(k1, -k2))]  (X(n, .) = 0)
+// V(k1, k2) と V(-k1, .) の4点から X の4点が決まるので, k1 行目と -k1 行目の組ごとに
+// 順変換 -> 固有値で割る -> 逆変換の入力 を rdft2d の形式のまま dp の中で行う (深度用の別の作業領域は不要).
+
+static fft_plan_t dct_plan;
+static float *dct_w = NULL;  // [n1 + n2][2]: W1(k1), W2(k2) の (cos, -sin)
+static float *dct_ev = NULL; // [n1 + n2]: 4 sin^2(pi k / 2n) (固有値 = -(ev1 + ev2))
+static int dct_max_h = 0;
+static int dct_max_w = 0;
+static int dct_tab_h = 0;
+static int dct_tab_w = 0;
+
+static bool dct_init(int height, int width)
+{
+    if (height <= dct_max_h && width <= dct_max_w)
+    {
+        return true;
+    }
+    if (!fft_plan_init(&dct_plan, height, width))
+    {
+        printf("depth_solver: unsupported size %dx%d\n", height, width);
+        return false;
+    }
+    free(dct_w);
+    free(dct_ev);
+    dct_w = (float *)malloc(sizeof(float) * (height + width) * 2);
+    dct_ev = (float *)malloc(sizeof(float) * (height + width));
+    dct_max_h = 0;
+    dct_max_w = 0;
+    dct_tab_h = 0;
+    dct_tab_w = 0;
+    if (!dct_w || !dct_ev)
+    {
+        printf("depth_solver: allocation failed\n");
+        return false;
+    }
+    dct_max_h = height;
+    dct_max_w = width;
+    return true;
+}
+
+static uint32_t dct_mem(int height, int width)
+{
+    return sizeof(float) * (height + width) * 3;
+}
+
+static void dct_build(int n1, int n2)
+{
+    if (n1 == dct_tab_h && n2 == dct_tab_w)
+    {
+        return;
+    }
+    for (int k = 0; k < n1 + n2; k++)
+    {
+        int n = (k < n1) ? n1 : n2;
+        double t = M_PI * (double)((k < n1) ? k : k - n1) / (2.0 * n);
+        double s = sin(t);
+        dct_w[2 * k] = (float)cos(t);
+        dct_w[2 * k + 1] = (float)-s;
+        dct_ev[k] = (float)(4.0 * s * s);
+    }
+    dct_tab_h = n1;
+    dct_tab_w = n2;
+}
+
+// v[r][c] = x[s(r)][s(c)] の逆 (x の n 番目が入る v の位置)
+static inline int dct_perm_inv(int n, int len)
+{
+    return (n & 1) ? len - 1 - (n >> 1) : (n >> 1);
+}
+
+// rdft2d の出力 (fft4f2d.c の rdft2d <case1>) から V(a, k2) = R - iI を読む (k2 = 0 .. n2/2)
+// ra: a 行目, rb: -a 行目 (どちらも退避したもの)
+static inline void dct_get(const float *ra, const float *rb, int a, int n1, int k2, int n2h,
+                           float *vr, float *vi)
+{
+    float r, im;
+
+    if (k2 > 0 && k2 < n2h)
+    {
+        r = ra[2 * k2];
+        im = ra[2 * k2 + 1];
+    }
+    else if (a == 0 || a == (n1 >> 1))
+    {
+        r = (k2 == 0) ? ra[0] : ra[1];
+        im = 0.0f;
+    }
+    else if (a < (n1 >> 1))
+    {
+        r = (k2 == 0) ? ra[0] : rb[1];
+        im = (k2 == 0) ? ra[1] : -rb[0];
+    }
+    else
+    {
+        r = (k2 == 0) ? rb[0] : ra[1];
+        im = (k2 == 0) ? -rb[1] : ra[0];
+    }
+    *vr = r;
+    *vi = -im;
+}
+
+// a 行目の列 k2, n2 - k2 の DCT を固有値で割ったもの (z0, z1)
+// (vr, vi) = V(a, k2), (nr, ni) = V(a, -k2)
+static inline void dct_solve_point(int a, int k2, int n1, int n2, float vr, float vi, float nr, float ni,
+                                   float *z0, float *z1)
+{
+    const float *w1 = dct_w + 2 * a;
+    const float *w2 = dct_w + 2 * (n1 + k2);
+
+    // A = W2 V(a, k2), B = conj(W2) V(a, -k2)
+    float ar = w2[0] * vr - w2[1] * vi;
+    float ai = w2[0] * vi + w2[1] * vr;
+    float br = w2[0] * nr + w2[1] * ni;
+    float bi = w2[0] * ni - w2[1] * nr;
+
+    // X(a, k2) = 1/2 Re[W1 (A + B)], X(a, n2 - k2) = -1/2 Im[W1 (A - B)]
+    float x0 = 0.5f * (w1[0] * (ar + br) - w1[1] * (ai + bi));
+    float x1 = -0.5f * (w1[0] * (ai - bi) + w1[1] * (ar - br));
+
+    *z0 = (a == 0 && k2 == 0) ? 0.0f : -x0 / (dct_ev[a] + dct_ev[n1 + k2]);
+    *z1 = (k2 == 0) ? 0.0f : -x1 / (dct_ev[a] + dct_ev[n1 + n2 - k2]);
+}
+
+// V'(a, k2) = conj(W1 W2) [(z0 - zb1) - i (zb0 + z1)] を R + iI (rdft2d の入力, I = -Im) で返す
+// z0, z1: Z(a, k2), Z(a, -k2), zb0, zb1: Z(-a, k2), Z(-a, -k2)
+static inline void dct_inverse_point(int a, int k2, int n1, float z0, float z1, float zb0, float zb1,
+                                     float *r, float *im)
+{
+    const float *w1 = dct_w + 2 * a;
+    const float *w2 = dct_w + 2 * (n1 + k2);
+    float wr = w1[0] * w2[0] - w1[1] * w2[1]; // W1 W2
+    float wi = w1[0] * w2[1] + w1[1] * w2[0];
+    float sr = z0 - zb1;
+    float si = -(zb0 + z1);
+
+    // conj(W) * s
+    *r = wr * sr + wi * si;
+    *im = -(wr * si - wi * sr);
+}
+
+// k1 行目と -k1 行目の組: 順変換のスペクトルを逆変換の入力に置き換える
+static void dct_pair(int n1, int n2, float **a, int k1)
+{
+    int m1 = (n1 - k1) & (n1 - 1);
+    int n2h = n2 >> 1;
+    bool self = (m1 == k1); // k1 = 0, n1/2
+    const float *sk = ds_pair[0];
+    const float *sm = self ? ds_pair[0] : ds_pair[1];
+    float *dk = a[k1];
+    float *dm = a[m1];
+
+    memcpy(ds_pair[0], a[k1], sizeof(float) * n2);
+    if (!self)
+    {
+        memcpy(ds_pair[1], a[m1], sizeof(float) * n2);
+    }
+
+    for (int k2 = 0; k2 <= n2h; k2++)
+    {
+        float vkr, vki, vmr, vmi;
+        float zk0, zk1, zm0, zm1;
+        float rk, ik, rm, im;
+
+        dct_get(sk, sm, k1, n1, k2, n2h, &vkr, &vki);
+        dct_get(sm, sk, m1, n1, k2, n2h, &vmr, &vmi);
+
+        // V(k1, -k2) = conj V(-k1, k2)
+        dct_solve_point(k1, k2, n1, n2, vkr, vki, vmr, -vmi, &zk0, &zk1);
+        dct_solve_point(m1, k2, n1, n2, vmr, vmi, vkr, -vki, &zm0, &zm1);
+
+        // Z(-k1, .) は k1 = 0 の時 0 (Z(n1, .))
+        dct_inverse_point(k1, k2, n1, zk0, zk1, k1 ? zm0 : 0.0f, k1 ? zm1 : 0.0f, &rk, &ik);
+
+        if (k2 > 0 && k2 < n2h)
+        {
+            dk[2 * k2] = rk;
+            dk[2 * k2 + 1] = ik;
+            if (!self)
+            {
+                dct_inverse_point(m1, k2, n1, zm0, zm1, zk0, zk1, &rm, &im);
+                dm[2 * k2] = rm;
+                dm[2 * k2 + 1] = im;
+            }
+        }
+        else if (self)
+        {
+            dk[(k2 == 0) ? 0 : 1] = rk;
+        }
+        else if (k2 == 0)
+        {
+            dk[0] = rk;
+            dk[1] = ik;
+        }
+        else
+        {
+            dm[1] = rk;
+            dm[0] = -ik;
+        }
+    }
+}
+
+static int32_t dct_solve(int height, int width, float **p, float **q, float **dp)
+{
+    int n1 = height;
+    int n2 = width;
+
+    if (dct_w == NULL || n1 < 4 || n2 < 8 || n1 > dct_max_h || n2 > dct_max_w ||
+        !fft_plan_init(&dct_plan, n1, n2))
+    {
+        return -1;
+    }
+    dct_build(n1, n2);
+
+    // 発散を並べ替えて dp に置く: v[r][c] = f[s(r)][s(c)]
+    for (int i = 0; i < n1; i++)
+    {
+        float *v = dp[dct_perm_inv(i, n1)];
+        ds_div_row(n1, n2, p, q, i, ds_row);
+        for (int j = 0; j < n2; j++)
+        {
+            v[dct_perm_inv(j, n2)] = ds_row[j];
+        }
+    }
+
+    rdft2d_plan(&dct_plan, 1, dp);
+    for (int k1 = 0; k1 <= (n1 >> 1); k1++)
+    {
+        dct_pair(n1, n2, dp, k1);
+    }
+    rdft2d_plan(&dct_plan, -1, dp);
+
+    // 並べ替えを戻す (列は1行ずつ, 行は巡回置換で入れ替える)
+    float scale = 2.0f / (float)(n1 * n2);
+    for (int i = 0; i < n1; i++)
+    {
+        float *v = dp[i];
+        memcpy(ds_row, v, sizeof(float) * n2);
+        for (int j = 0; j < n2; j++)
+        {
+            v[j] = ds_row[dct_perm_inv(j, n2)] * scale;
+        }
+    }
+    memset(ds_done, 0, n1);
+    for (int i = 0; i < n1; i++)
+    {
+        int cur = i;
+        if (ds_done[i])
+        {
+            continue;
+        }
+        memcpy(ds_pair[0], dp[i], sizeof(float) * n2);
+        for (;;)
+        {
+            int src = dct_perm_inv(cur, n1);
+            ds_done[cur] = 1;
+            if (src == i)
+            {
+                memcpy(dp[cur], ds_pair[0], sizeof(float) * n2);
+                break;
+            }
+            memcpy(dp[cur], dp[src], sizeof(float) * n2);
+            cur = src;
+        }
+    }
+    return 0;
+}
+
+// ---- multigrid ----
+//
+// 方程式は DCT と同じ (各画素で sum(z[隣] - z) = f, 隣は画像の内側だけ).
+// 平滑化は red-black Gauss-Seidel. 赤のライン i の直後に黒のライン i - 1 を更新すると
+// 全体の赤 -> 黒 と同じ結果になるので, 1回のスイープは画像を上から1回読むだけで済む.
+// 制限は 2x2 の残差の和 (残差は2ラインずつその場で求める), 補間は双線形 (セル中心).
+
+typedef struct
+{
+    int h;
+    int w;
+    float **z;
+    float **f;
+} mg_level_t;
+
+static mg_level_t mg_lv[MG_MAX_LEVELS];
+static int mg_nlev = 0;
+static float *mg_data = NULL; // レベル 1 以降の z, f
+static float **mg_rows = NULL;
+static int mg_max_h = 0;
+static int mg_max_w = 0;
+
+static const float mg_inv[5] = {0.0f, 1.0f, 0.5f, 1.0f / 3.0f, 0.25f};
+
+// height x width から粗いレベルの (z, f の) 画素数と行数
+static void mg_size(int height, int width, uint32_t *pixels, uint32_t *rows)
+{
+    int h = height;
+    int w = width;
+    int n = 1;
+
+    *pixels = 0;
+    *rows = 0;
+    while (n < MG_MAX_LEVELS && (h & 1) == 0 && (w & 1) == 0 && h / 2 >= DEPTH_MG_MIN && w / 2 >= DEPTH_MG_MIN)
+    {
+        h >>= 1;
+        w >>= 1;
+        *pixels += 2 * h * w;
+        *rows += 2 * h;
+        n++;
+    }
+}
+
+static bool mg_init(int height, int width)
+{
+    uint32_t pixels, rows;
+
+    if (height <= mg_max_h && width <= mg_max_w)
+    {
+        return true;
+    }
+    if (width > DS_MAX_W)
+    {
+        printf("depth_solver: unsupported size %dx%d\n", height, width);
+        return false;
+    }
+    mg_size(height, width, &pixels, &rows);
+    free(mg_data);
+    free(mg_rows);
+    mg_data = (float *)malloc(sizeof(float) * (pixels ? pixels : 1));
+    mg_rows = (float **)malloc(sizeof(float *) * (rows ? rows : 1));
+    mg_max_h = 0;
+    mg_max_w = 0;
+    if (!mg_data || !mg_rows)
+    {
+        printf("depth_solver: allocation failed\n");
+        return false;
+    }
+    mg_max_h = height;
+    mg_max_w = width;
+    return true;
+}
+
+static uint32_t mg_mem(int height, int width)
+{
+    uint32_t pixels, rows;
+
+    mg_size(height, width, &pixels, &rows);
+    return sizeof(float) * pixels + sizeof(float *) * rows;
+}
+
+// レベル 1 以降を作業領域に割り当てる (レベル 0 は呼び出し側の配列)
+static void mg_setup(int height, int width)
+{
+    float *d = mg_data;
+    float **r = mg_rows;
+    int h = height;
+    int w = width;
+
+    mg_nlev = 1;
+    while (mg_nlev < MG_MAX_LEVELS && (h & 1) == 0 && (w & 1) == 0 && h / 2 >= DEPTH_MG_MIN && w / 2 >= DEPTH_MG_MIN)
+    {
+        mg_level_t *lv = &mg_lv[mg_nlev++];
+        h >>= 1;
+        w >>= 1;
+        lv->h = h;
+        lv->w = w;
+        lv->z = r;
+        lv->f = r + h;
+        for (int i = 0; i < h; i++, d += 2 * w)
+        {
+            lv->z[i] = d;
+            lv->f[i] = d + w;
+        }
+        r += 2 * h;
+    }
+}
+
+// ライン i の color (0: 赤 (i + j 偶数), 1: 黒) の画素を更新
+static void mg_relax_line(const mg_level_t *lv, int i, int color)
+{
+    int w = lv->w;
+    float *z = lv->z[i];
+    const float *f = lv->f[i];
+    const float *zu = (i > 0) ? lv->z[i - 1] : NULL;
+    const float *zd = (i < lv->h - 1) ? lv->z[i + 1] : NULL;
+    int nv = (zu != NULL) + (zd != NULL);
+    int j = (i + color) & 1;
+
+    for (; j < w; j += 2)
+    {
+        float s = -f[j];
+        int n = nv;
+        if (zu)
+            s += zu[j];
+        if (zd)
+            s += zd[j];
+        if (j > 0)
+        {
+            s += z[j - 1];
+            n++;
+        }
+        if (j < w - 1)
+        {
+            s += z[j + 1];
+            n++;
+        }
+        z[j] = s * mg_inv[n];
+    }
+}
+
+static void mg_smooth(const mg_level_t *lv, int sweeps)
+{
+    for (int s = 0; s < sweeps; s++)
+    {
+        for (int i = 0; i <= lv->h; i++)
+        {
+            if (i < lv->h)
+                mg_relax_line(lv, i, 0);
+            if (i > 0)
+                mg_relax_line(lv, i - 1, 1);
+        }
+    }
+}
+
+// ライン i の残差 r = f - Az
+static void mg_residual_line(const mg_level_t *lv, int i, float *r)
+{
+    int w = lv->w;
+    const float *z = lv->z[i];
+    const float *f = lv->f[i];
+    const float *zu = (i > 0) ? lv->z[i - 1] : NULL;
+    const float *zd = (i < lv->h - 1) ? lv->z[i + 1] : NULL;
+
+    for (int j = 0; j < w; j++)
+    {
+        float a = 0.0f;
+        if (zu)
+            a += zu[j] - z[j];
+        if (zd)
+            a += zd[j] - z[j];
+        if (j > 0)
+            a += z[j - 1] - z[j];
+        if (j < w - 1)
+            a += z[j + 1] - z[j];
+        r[j] = f[j] - a;
+    }
+}
+
+// 残差を粗いレベルの f へ (2x2 の和). 粗いレベルの z は 0 から
+static void mg_restrict(const mg_level_t *lv, const mg_level_t *cv)
+{
+    for (int i = 0; i < cv->h; i++)
+    {
+        float *f = cv->f[i];
+        mg_residual_line(lv, 2 * i, ds_pair[0]);
+        mg_residual_line(lv, 2 * i + 1, ds_pair[1]);
+        for (int j = 0; j < cv->w; j++)
+        {
+            f[j] = ds_pair[0][2 * j] + ds_pair[0][2 * j + 1] + ds_pair[1][2 * j] + ds_pair[1][2 * j + 1];
+        }
+        memset(cv->z[i], 0, sizeof(float) * cv->w);
+    }
+}
+
+// 粗いレベルの修正を双線形補間で足す (重み 9/16, 3/16, 3/16, 1/16)
+static void mg_prolong(const mg_level_t *lv, const mg_level_t *cv)
+{
+    for (int i = 0; i < lv->h; i++)
+    {
+        int ci = i >> 1;
+        int ni = (i & 1) ? ci + 1 : ci - 1;
+        ni = (ni < 0) ? 0 : (ni >= cv->h ? cv->h - 1 : ni);
+        const float *c0 = cv->z[ci];
+        const float *c1 = cv->z[ni];
+        float *z = lv->z[i];
+        for (int j = 0; j < lv->w; j++)
+        {
+            int cj = j >> 1;
+            int nj = (j & 1) ? cj + 1 : cj - 1;
+            nj = (nj < 0) ? 0 : (nj >= cv->w ? cv->w - 1 : nj);
+            z[j] += (9.0f * c0[cj] + 3.0f * (c0[nj] + c1[cj]) + c1[nj]) * (1.0f / 16.0f);
+        }
+    }
+}
+
+static void mg_vcycle(int l)
+{
+    const mg_level_t *lv = &mg_lv[l];
+
+    if (l == mg_nlev - 1)
+    {
+        mg_smooth(lv, DEPTH_MG_COARSE);
+        return;
+    }
+    mg_smooth(lv, DEPTH_MG_PRE);
+    mg_restrict(lv, &mg_lv[l + 1]);
+    mg_vcycle(l + 1);
+    mg_prolong(lv, &mg_lv[l + 1]);
+    mg_smooth(lv, DEPTH_MG_POST);
+}
+
+static int32_t mg_solve(int height, int width, float **p, float **q, float **dp)
+{
+    if (mg_data == NULL || height < 2 || width < 2 || height > mg_max_h || width > mg_max_w)
+    {
+        return -1;
+    }
+    mg_setup(height, width);
+
+    // 発散は p の各行にその場で書く (ライン i は p[i] と q[i - 1 .. i + 1] だけから決まる)
+    for (int i = 0; i < height; i++)
+    {
+        ds_div_row(height, width, p, q, i, ds_row);
+        memcpy(p[i], ds_row, sizeof(float) * width);
+        memset(dp[i], 0, sizeof(float) * width);
+    }
+    mg_lv[0].h = height;
+    mg_lv[0].w = width;
+    mg_lv[0].z = dp;
+    mg_lv[0].f = p;
+
+    for (int c = 0; c < DEPTH_MG_CYCLES; c++)
+    {
+        mg_vcycle(0);
+    }
+
+    // Neumann 境界の解は定数の分だけ不定. 平均を 0 にする
+    double sum = 0.0;
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            sum += dp[i][j];
+        }
+    }
+    float mean = (float)(sum / ((double)height * width));
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            dp[i][j] -= mean;
+        }
+    }
+    return 0;
+}
+
+// ---- registry ----
+
+static const depth_solver_t depth_solvers[DEPTH_SOLVER_NUM] = {
+    {"FC", true, fc_init, fcmethod_packed, fc_mem},
+    {"DCT", false, dct_init, dct_solve, dct_mem},
+    {"MG", false, mg_init, mg_solve, mg_mem},
+};
+
+const depth_solver_t *depth_solver(int id)
+{
+    if (id < 0 || id >= DEPTH_SOLVER_NUM)
+    {
+        return NULL;
+    }
+    return &depth_solvers[id];
+}
+
+// ---- benchmark ----
+
+static float **bench_alloc(int n)
+{
+    float **a = (float **)malloc(sizeof(float *) * n);
+    float *d = (float *)malloc(sizeof(float) * n * n);
+
+    if (!a || !d)
+    {
+        free(a);
+        free(d);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++)
+    {
+        a[i] = d + i * n;
+    }
+    return a;
+}
+
+static void bench_free(float **a)
+{
+    if (a)
+    {
+        free(a[0]);
+        free(a);
+    }
+}
+
+// ガウス形の山 z (高さ n/8, 幅 n/8) の勾配 (dz/dx = -2p, dz/dy = 2q)
+static void bench_surface(int n, float **p, float **q, float **z)
+{
+    float c = 0.5f * n;
+    float s = n / 8.0f;
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            float x = j - c;
+            float y = i - c;
+            float h = s * expf(-(x * x + y * y) / (2.0f * s * s));
+            if (z)
+                z[i][j] = h;
+            p[i][j] = 0.5f * h * x / (s * s);
+            q[i][j] = -0.5f * h * y / (s * s);
+        }
+    }
+}
+
+// 平均を除いた差の RMS
+static float bench_rms(int n, float **a, float **b)
+{
+    double ma = 0.0, mb = 0.0, e = 0.0;
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            ma += a[i][j];
+            mb += b[i][j];
+        }
+    }
+    ma /= (double)n * n;
+    mb /= (double)n * n;
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            double d = (a[i][j] - ma) - (b[i][j] - mb);
+            e += d * d;
+        }
+    }
+    return (float)sqrt(e / ((double)n * n));
+}
+
+void depth_solver_bench(void)
+{
+    static const int sizes[] = {128, 256, 512};
+
+    for (int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++)
+    {
+        int n = sizes[s];
+        float **p = bench_alloc(n);
+        float **q = bench_alloc(n);
+        float **z = bench_alloc(n);
+        float **dp = bench_alloc(n);
+
+        if (!p || !q || !z || !dp)
+        {
+            printf("depth_solver_bench: %dx%d allocation failed\n", n, n);
+        }
+        for (int id = 0; p && q && z && dp && id < DEPTH_SOLVER_NUM; id++)
+        {
+            const depth_solver_t *ds = depth_solver(id);
+            bench_surface(n, p, q, z);
+            // FC: fc_init() keeps an existing work area (cam.c), which may be smaller than n. allocate it for n
+            bool ok = (id == DEPTH_SOLVER_FC) ? init_fc_packed(n, n) : ds->init(n, n);
+            if (!ok)
+            {
+                printf("depth_solver %-3s %3dx%-3d: no memory\n", ds->name, n, n);
+                continue;
+            }
+            uint32_t t0 = time_us_32();
+            int32_t ret = ds->solve(n, n, p, q, dp);
+            uint32_t t1 = time_us_32();
+            if (ret < 0)
+            {
+                printf("depth_solver %-3s %3dx%-3d: unsupported (initialized size)\n", ds->name, n, n);
+                continue;
+            }
+            printf("depth_solver %-3s %3dx%-3d: %8u us, work %8u bytes, rms %.4f\n", ds->name, n, n,
+                   (unsigned)(t1 - t0), (unsigned)ds->mem(n, n), bench_rms(n, dp, z));
+        }
+        bench_free(p);
+        bench_free(q);
+        bench_free(z);
+        bench_free(dp);
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef __DEPTH_SOLVER_H__
+#define __DEPTH_SOLVER_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// 勾配 (p, q) から深度を求めるソルバ (実行時に切り替える)
+//
+//  DEPTH_SOLVER_FC:  Frankot-Chellappa (fcmethod_packed()). 周期境界なので画像の枠をゼロにする必要がある
+//  DEPTH_SOLVER_DCT: Neumann 境界のポアソン方程式を DCT-II/III で解く (Simchony).
+//                    DCT は rdft2d (fft4f2d.c) の入出力の並べ替えで作る (Makhoul). パディング不要
+//  DEPTH_SOLVER_MG:  同じ方程式を multigrid (V-cycle, 回数固定) で解く. FFT を使わず,
+//                    各スイープは3ライン分ずつ順に処理するのでバンド (タイル) 単位で回せる.
+//                    サイズは2のべき乗でなくてもよい
+//
+// 引数は fcmethod_packed() と同じ (height x width, dp は float の深度マップ).
+// DCT/MG の深度は fcmethod() と同じ向きとスケール (dz/dx = -2p, dz/dy = 2q) で平均 0.
+// MG は p の内容を作業に使う (壊す). DCT は p, q を壊さない.
+
+enum
+{
+    DEPTH_SOLVER_FC = 0,
+    DEPTH_SOLVER_DCT,
+    DEPTH_SOLVER_MG,
+    DEPTH_SOLVER_NUM
+};
+
+#define DEPTH_MG_CYCLES (4)  // V-cycle の回数
+#define DEPTH_MG_PRE (2)     // 各レベルの前/後の red-black Gauss-Seidel の回数
+#define DEPTH_MG_POST (2)
+#define DEPTH_MG_COARSE (40) // 最も粗いレベル (一辺 4 .. 7) の反復回数
+#define DEPTH_MG_MIN (4)     // 最も粗いレベルの一辺の下限
+
+typedef struct
+{
+    const char *name;
+    bool periodic; // true: 周期境界 (画像の枠のゼロ埋めが必要)
+    // 作業領域の確保 (最大サイズで呼ぶ. 確保済みなら何もしない)
+    bool (*init)(int height, int width);
+    // return: 0 = OK, -1 = サイズ不正 / 未初期化
+    int32_t (*solve)(int height, int width, float **p, float **q, float **dp);
+    // height x width での作業領域のバイト数 (p, q, dp と SRAM の1行分のバッファは含まない)
+    uint32_t (*mem)(int height, int width);
+} depth_solver_t;
+
+// id: DEPTH_SOLVER_*. 範囲外なら NULL
+const depth_solver_t *depth_solver(int id);
+
+// 各ソルバの時間と作業領域を 128, 256, 512 で比較して表示する (ガウス形の山の勾配, 誤差は元の面との RMS)
+// FC の作業領域はサイズ毎に init_fc_packed() で確保し直す (cam.c の FC の面も解放される).
+// 作業領域を確保し直すので, 起動時に init_fc_packed_banks() より前に呼ぶこと
+void depth_solver_bench(void);
+
+#endif //__DEPTH_SOLVER_H__
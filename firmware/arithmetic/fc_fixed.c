@@ -0,0 +1,429 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "fc_fixed.h"
+#include "sfe_pico_alloc.h"
+
+#define FX_U_Q (20)                 // u, v の小数部のビット数
+#define FX_PI_Q28 (843314857LL)     // pi * 2^28
+
+// 作業領域 fx_c[FX_H][2 * FX_W] (Q31 の re, im 交互)
+// 勾配を受け取る時は 行の前半 = p (float), 後半 = q (float)
+static int32_t **fx_c = NULL;
+static float **fx_view[2] = {NULL, NULL};
+static int fx_max_h = 0;
+static int fx_max_w = 0;
+
+static int32_t fx_tw[FFT_PLAN_MAX];          // exp(-2*pi*i*k/FFT_PLAN_MAX), k < FFT_PLAN_MAX/2 (Q31, re, im 交互)
+static int32_t fx_line[2 * FFT_PLAN_MAX];    // 列(縦)のFFT用 (SRAM)
+static float fx_rowf[2][FFT_PLAN_MAX];       // 勾配1行分 (float -> Q31 変換用)
+static int8_t fx_exp_row[FFT_PLAN_MAX];      // 行ごとの指数
+static int8_t fx_exp_col[FFT_PLAN_MAX];      // 列ごとの指数
+static int32_t fx_u[FFT_PLAN_MAX];           // x方向の周波数 (Q20)
+static int32_t fx_v[FFT_PLAN_MAX];           // y方向の周波数 (Q20)
+static int32_t *fx_tf = NULL;                // 伝達関数 (alpha, beta: Q16) の表 [n1/2 + 1][n2][2]. サイズが変わった時だけ作る
+static int fx_tf_h = 0;
+static int fx_tf_w = 0;
+
+static inline uint32_t fx_abs(int32_t x)
+{
+    return (x < 0) ? (uint32_t)(-(int64_t)x) : (uint32_t)x;
+}
+
+// m < 2^fx_bits(m)
+static inline int fx_bits(uint32_t m)
+{
+    return (m == 0) ? 0 : 32 - __builtin_clz(m);
+}
+
+static inline int32_t fx_shr(int32_t x, int sh)
+{
+    return (sh > 31) ? 0 : (x >> sh);
+}
+
+// 作業領域をすべて解放する (再確保の前, 確保失敗時)
+static void fx_free(void)
+{
+    if (fx_c)
+        free(fx_c[0]);
+    free(fx_c);
+    free(fx_view[0]);
+    free(fx_view[1]);
+    free(fx_tf);
+    fx_c = NULL;
+    fx_view[0] = NULL;
+    fx_view[1] = NULL;
+    fx_tf = NULL;
+    fx_max_h = 0;
+    fx_max_w = 0;
+    fx_tf_h = 0;
+    fx_tf_w = 0;
+}
+
+bool init_fc_fixed(int height, int width)
+{
+    int i;
+
+    if (height > FFT_PLAN_MAX || width > FFT_PLAN_MAX)
+    {
+        printf("fc_fixed: unsupported size %dx%d\n", height, width);
+        return false;
+    }
+    fx_free();
+    int32_t **rows = (int32_t **)sfe_mem_malloc_fast(sizeof(int32_t *) * height, 0);
+    fx_view[0] = (float **)sfe_mem_malloc_fast(sizeof(float *) * height, 0);
+    fx_view[1] = (float **)sfe_mem_malloc_fast(sizeof(float *) * height, 0);
+    int32_t *d = (int32_t *)sfe_mem_malloc_bulk(sizeof(int32_t) * height * width * 2, 0);
+    fx_tf = (int32_t *)sfe_mem_malloc_bulk(sizeof(int32_t) * (height / 2 + 1) * width * 2, 0);
+    if (!rows || !fx_view[0] || !fx_view[1] || !d || !fx_tf)
+    {
+        printf("fc_fixed: allocation failed\n");
+        free(rows);
+        free(d);
+        fx_free();
+        return false;
+    }
+    // fx_c は行と d がそろってから (fx_free() は fx_c[0] を d として解放する)
+    fx_c = rows;
+    for (i = 0; i < height; i++)
+    {
+        fx_c[i] = d + i * width * 2;
+        fx_view[0][i] = (float *)fx_c[i];
+        fx_view[1][i] = (float *)(fx_c[i] + width);
+    }
+    for (i = 0; i < FFT_PLAN_MAX / 2; i++)
+    {
+        double t = 2.0 * M_PI * i / FFT_PLAN_MAX;
+        double c = cos(t) * 2147483648.0;
+        fx_tw[2 * i] = (c >= 2147483647.0) ? 0x7fffffff : (int32_t)lround(c);
+        fx_tw[2 * i + 1] = (int32_t)lround(-sin(t) * 2147483648.0);
+    }
+    fx_max_h = height;
+    fx_max_w = width;
+    fx_tf_h = 0;
+    fx_tf_w = 0;
+    return true;
+}
+
+float **fc_fixed_view(int which)
+{
+    return fx_view[which & 1];
+}
+
+q15_t **alloc_2d_q15(int n1, int n2)
+{
+    q15_t **dd = (q15_t **)sfe_mem_malloc_fast(sizeof(q15_t *) * n1, 0);
+    q15_t *d = (q15_t *)sfe_mem_malloc_bulk(sizeof(q15_t) * n1 * n2, 0);
+
+    if (!dd || !d)
+    {
+        free(dd);
+        free(d);
+        return NULL;
+    }
+    for (int j = 0; j < n1; j++)
+    {
+        dd[j] = d + j * n2;
+    }
+    return dd;
+}
+
+// n点の複素FFT (exp(-i..), Q31, in-place, x[2n] = re, im 交互)
+// 最初に最大値を 2^(FC_FIXED_GUARD-1) 以上にそろえ, 各段の入力が 2^FC_FIXED_GUARD 未満になるようにスケールする.
+// (1段の増加は最大 1 + sqrt(2) 倍なので出力は 2^31 を超えない)
+// return: 指数の増分 (真のDFT = x * 2^ret)
+static int fx_fft1d(int32_t *x, int n)
+{
+    int i, j, k, len, half, step, sh, bit;
+    int e = 0;
+    uint32_t m = 0;
+    int32_t t;
+
+    for (i = 0; i < 2 * n; i++)
+    {
+        m |= fx_abs(x[i]);
+    }
+    if (m == 0)
+    {
+        return 0;
+    }
+    sh = FC_FIXED_GUARD - fx_bits(m);
+    for (i = 0; i < 2 * n; i++)
+    {
+        x[i] = (sh >= 0) ? (int32_t)((uint32_t)x[i] << sh) : (x[i] >> -sh);
+    }
+    e -= sh;
+
+    // ビット反転
+    for (i = 1, j = 0; i < n; i++)
+    {
+        for (bit = n >> 1; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            t = x[2 * i];
+            x[2 * i] = x[2 * j];
+            x[2 * j] = t;
+            t = x[2 * i + 1];
+            x[2 * i + 1] = x[2 * j + 1];
+            x[2 * j + 1] = t;
+        }
+    }
+
+    m = 0;
+    for (len = 2; len <= n; len <<= 1)
+    {
+        half = len >> 1;
+        step = FFT_PLAN_MAX / len;
+        sh = fx_bits(m) - FC_FIXED_GUARD;
+        sh = (sh > 0) ? sh : 0;
+        e += sh;
+        m = 0;
+        for (k = 0; k < half; k++)
+        {
+            int32_t wr = fx_tw[2 * k * step];
+            int32_t wi = fx_tw[2 * k * step + 1];
+            for (i = k; i < n; i += len)
+            {
+                int32_t *a = x + 2 * i;
+                int32_t *b = a + 2 * half;
+                int32_t tr = (int32_t)(((int64_t)b[0] * wr - (int64_t)b[1] * wi) >> (31 + sh));
+                int32_t ti = (int32_t)(((int64_t)b[0] * wi + (int64_t)b[1] * wr) >> (31 + sh));
+                int32_t ar = a[0] >> sh;
+                int32_t ai = a[1] >> sh;
+                a[0] = ar + tr;
+                a[1] = ai + ti;
+                b[0] = ar - tr;
+                b[1] = ai - ti;
+                m |= fx_abs(a[0]) | fx_abs(a[1]) | fx_abs(b[0]) | fx_abs(b[1]);
+            }
+        }
+    }
+    return e;
+}
+
+// 2次元FFT. 行 -> 列の順に変換し, 行の指数は列の変換前にそろえる. 列の指数は fx_exp_col に残す.
+// re_only: 列の変換結果は実部だけ書き戻す (逆変換用)
+// return: 行の指数の最大値
+static int fx_fft2d(int n1, int n2, bool re_only)
+{
+    int i, j, er = -128;
+
+    for (i = 0; i < n1; i++)
+    {
+        fx_exp_row[i] = fx_fft1d(fx_c[i], n2);
+        er = (fx_exp_row[i] > er) ? fx_exp_row[i] : er;
+    }
+    for (j = 0; j < n2; j++)
+    {
+        for (i = 0; i < n1; i++)
+        {
+            fx_line[2 * i] = fx_shr(fx_c[i][2 * j], er - fx_exp_row[i]);
+            fx_line[2 * i + 1] = fx_shr(fx_c[i][2 * j + 1], er - fx_exp_row[i]);
+        }
+        fx_exp_col[j] = fx_fft1d(fx_line, n1);
+        for (i = 0; i < n1; i++)
+        {
+            fx_c[i][2 * j] = fx_line[2 * i];
+            if (!re_only)
+            {
+                fx_c[i][2 * j + 1] = fx_line[2 * i + 1];
+            }
+        }
+    }
+    return er;
+}
+
+static int fx_max_exp_col(int n2)
+{
+    int j, ec = -128;
+
+    for (j = 0; j < n2; j++)
+    {
+        ec = (fx_exp_col[j] > ec) ? fx_exp_col[j] : ec;
+    }
+    return ec;
+}
+
+// 1/d (d: Q40) の近似. 1/d = r * 2^-(31 + *s)
+static inline uint32_t fx_recip(uint64_t d, int *s)
+{
+    int bits = 64 - __builtin_clzll(d);
+    *s = (bits > 16) ? bits - 16 : 0;
+    return 0x80000000u / (uint32_t)(d >> *s);
+}
+
+// u / d (u: Q20, 1/d = r * 2^-(31 + s)) を Q16 で
+static inline int64_t fx_div_q16(int32_t u, uint32_t r, int s)
+{
+    int64_t x = (int64_t)u * r;
+    return (s >= 5) ? (x >> (s - 5)) : x * (1 << (5 - s));
+}
+
+// matlab: ifftshift(linspace(-pi/2, pi/2, n)) (Q20, 符号は dir)
+static void fx_freq(int32_t *f, int n, int dir)
+{
+    for (int j = 0; j < n; j++)
+    {
+        int64_t idx = (j + (n >> 1)) & (n - 1);
+        // pi * (2 idx - (n - 1)) / (2 (n - 1)) * 2^20
+        int64_t x = FX_PI_Q28 * (2 * idx - (n - 1)) / (2 * (n - 1));
+        f[j] = (int32_t)(dir * ((x + 128) >> 8));
+    }
+}
+
+// 伝達関数の表 (fc_solver.c の fc_build_tf() の固定小数点版). k1 = 0 .. n1/2 の行だけ
+static void fx_build_tf(int n1, int n2)
+{
+    if (n1 == fx_tf_h && n2 == fx_tf_w)
+    {
+        return;
+    }
+    fx_freq(fx_u, n2, 1);
+    fx_freq(fx_v, n1, -1);
+    for (int i = 0; i <= n1 / 2; i++)
+    {
+        int m1 = (n1 - i) & (n1 - 1);
+        int32_t *tf = fx_tf + i * n2 * 2;
+        for (int j = 0; j < n2; j++)
+        {
+            int m2 = (n2 - j) & (n2 - 1);
+            uint64_t dk = (i == 0 && j == 0) ? (1ULL << (2 * FX_U_Q))
+                                             : (uint64_t)((int64_t)fx_u[j] * fx_u[j] + (int64_t)fx_v[i] * fx_v[i]);
+            uint64_t dm = (m1 == 0 && m2 == 0) ? (1ULL << (2 * FX_U_Q))
+                                               : (uint64_t)((int64_t)fx_u[m2] * fx_u[m2] + (int64_t)fx_v[m1] * fx_v[m1]);
+            int sk, sm;
+            uint32_t rk = fx_recip(dk, &sk);
+            uint32_t rm = fx_recip(dm, &sm);
+            tf[2 * j] = (int32_t)((fx_div_q16(fx_u[j], rk, sk) - fx_div_q16(fx_u[m2], rm, sm)) >> 1);
+            tf[2 * j + 1] = (int32_t)((fx_div_q16(fx_v[i], rk, sk) - fx_div_q16(fx_v[m1], rm, sm)) >> 1);
+        }
+    }
+    fx_tf_h = n1;
+    fx_tf_w = n2;
+}
+
+int32_t fcmethod_fixed(int height, int width,
+                       float **p, float **q,
+                       q15_t **dp, int32_t *dp_exp)
+{
+    int i, j, e, f, er, ec;
+    int n1 = height;
+    int n2 = width;
+    float mx = 0.0f;
+
+    if (fx_c == NULL || n1 < 4 || n2 < 4 || n1 > fx_max_h || n2 > fx_max_w ||
+        (n1 & (n1 - 1)) != 0 || (n2 & (n2 - 1)) != 0)
+    {
+        return -1;
+    }
+
+    // 勾配の最大値から入力の指数を決める (p = x * 2^-f, |x| < 2^FC_FIXED_GUARD)
+    for (i = 0; i < n1; i++)
+    {
+        for (j = 0; j < n2; j++)
+        {
+            float a = fabsf(p[i][j]);
+            float b = fabsf(q[i][j]);
+            mx = (a > mx) ? a : mx;
+            mx = (b > mx) ? b : mx;
+        }
+    }
+    if (!(mx > 0.0f))
+    {
+        for (i = 0; i < n1; i++)
+        {
+            memset(dp[i], 0, sizeof(q15_t) * n2);
+        }
+        *dp_exp = 0;
+        return 0;
+    }
+    frexpf(mx, &e);
+    f = FC_FIXED_GUARD - e;
+
+    // パッキング: x = p + i*q (p, q が作業領域の中にあっても行単位でコピーしてから書く)
+    for (i = 0; i < n1; i++)
+    {
+        memcpy(fx_rowf[0], p[i], sizeof(float) * n2);
+        memcpy(fx_rowf[1], q[i], sizeof(float) * n2);
+        for (j = 0; j < n2; j++)
+        {
+            fx_c[i][2 * j] = (int32_t)lrintf(ldexpf(fx_rowf[0][j], f));
+            fx_c[i][2 * j + 1] = (int32_t)lrintf(ldexpf(fx_rowf[1][j], f));
+        }
+    }
+
+    // 順変換: C = fx_c * 2^(e - f)
+    er = fx_fft2d(n1, n2, false);
+    ec = fx_max_exp_col(n2);
+    e = er + ec;
+
+    fx_build_tf(n1, n2);
+
+    // 伝達関数 (fc_solver.c の fc_spectrum と同じ式). k と -k の組ごとにその場で書き換える
+    // 逆変換は conj(Zh) の順変換の実部を取る
+    for (i = 0; i <= n1 / 2; i++)
+    {
+        int m1 = (n1 - i) & (n1 - 1);
+        const int32_t *tf = fx_tf + i * n2 * 2;
+        for (j = 0; j < n2; j++)
+        {
+            int m2 = (n2 - j) & (n2 - 1);
+            if (i * n2 + j > m1 * n2 + m2)
+            {
+                continue;
+            }
+            int32_t cr = fx_shr(fx_c[i][2 * j], ec - fx_exp_col[j]);
+            int32_t ci = fx_shr(fx_c[i][2 * j + 1], ec - fx_exp_col[j]);
+            int32_t mr = fx_shr(fx_c[m1][2 * m2], ec - fx_exp_col[m2]);
+            int32_t mi = fx_shr(fx_c[m1][2 * m2 + 1], ec - fx_exp_col[m2]);
+            int64_t pr = ((int64_t)cr + mr) >> 1;
+            int64_t pi = ((int64_t)ci - mi) >> 1;
+            int64_t qr = ((int64_t)ci + mi) >> 1;
+            int64_t qi = ((int64_t)mr - cr) >> 1;
+            int64_t alpha = tf[2 * j];
+            int64_t beta = tf[2 * j + 1];
+
+            int32_t sr = (int32_t)((alpha * pr + beta * qr) >> (16 + FC_FIXED_TF_SHIFT));
+            int32_t si = (int32_t)((alpha * pi + beta * qi) >> (16 + FC_FIXED_TF_SHIFT));
+
+            // Zh(k) = (-si, sr), Zh(-k) = conj(Zh(k))
+            fx_c[m1][2 * m2] = -si;
+            fx_c[m1][2 * m2 + 1] = sr;
+            fx_c[i][2 * j] = -si;
+            fx_c[i][2 * j + 1] = -sr;
+        }
+    }
+    e += FC_FIXED_TF_SHIFT;
+
+    // 逆変換 (1 / (n1 n2) は指数で)
+    er = fx_fft2d(n1, n2, true);
+    ec = fx_max_exp_col(n2);
+    e += er + ec - __builtin_ctz(n1) - __builtin_ctz(n2);
+
+    // Q15 に丸める
+    uint32_t m = 0;
+    for (i = 0; i < n1; i++)
+    {
+        for (j = 0; j < n2; j++)
+        {
+            m |= fx_abs(fx_shr(fx_c[i][2 * j], ec - fx_exp_col[j]));
+        }
+    }
+    int r = fx_bits(m) - 15;
+    r = (r > 0) ? r : 0;
+    for (i = 0; i < n1; i++)
+    {
+        for (j = 0; j < n2; j++)
+        {
+            dp[i][j] = (q15_t)fx_shr(fx_c[i][2 * j], ec - fx_exp_col[j] + r);
+        }
+    }
+    *dp_exp = e + r - f;
+    return 0;
+}
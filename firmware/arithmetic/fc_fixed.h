@@ -0,0 +1,40 @@
+#ifndef __FC_FIXED_H__
+#define __FC_FIXED_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "fft_plan.h"
+
+// Frankot-Chellappa (固定小数点版)
+//
+// fcmethod_packed() と同じ手順 (p + i*q の複素FFT -> スペクトル分離 -> 伝達関数 -> 逆変換) を
+// 整数演算で行う. FPUの無いコアやFPUより整数積和が速い場合向け.
+//  - FFT: Q31 のブロック浮動小数点 (各段の前に最大値を見て, 必要な時だけ 1/2 にスケールする)
+//  - 伝達関数: 係数は Q16, 積和は 64bit
+//  - 深度: Q15 (depth = dp[i][j] * 2^dp_exp). float の深度マップの半分のサイズ
+// 入力の勾配は float (estimate_*() の出力). 作業領域の半分ずつを float の行として渡し,
+// 行ごとに Q31 へ変換してその場で複素数に並べ替える (勾配マップ用の追加メモリは不要).
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+#define FC_FIXED_GUARD (29) // FFT各段の入力の最大値 (2^29 以上なら 1/2 にスケール)
+#define FC_FIXED_TF_SHIFT (9) // 伝達関数の積和の余裕 (|u/d| <= 2^8.4, FFT_PLAN_MAX = 512)
+
+// 作業領域の確保 (最大サイズで1回だけ呼ぶ. FFT_PLAN_MAX 以下)
+bool init_fc_fixed(int height, int width);
+
+// 勾配の出力先 (which: 0 = 実部側, 1 = 虚部側). fc_packed_view() と同じ使い方
+float **fc_fixed_view(int which);
+
+q15_t **alloc_2d_q15(int n1, int n2);
+
+// input:  p, q: 勾配 (height x width, fc_fixed_view() か任意の2次元配列)
+// output: dp: 深度 Q15 (height x width), *dp_exp: 深度の指数
+// return: 0 = OK, -1 = サイズ不正 / 未初期化
+int32_t fcmethod_fixed(int height, int width,
+                       float **p, float **q,
+                       q15_t **dp, int32_t *dp_exp);
+
+#endif //__FC_FIXED_H__
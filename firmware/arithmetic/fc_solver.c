@@ -0,0 +1,442 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "fc_solver.h"
+#include "fft_mixed.h"
+#include "sfe_pico_alloc.h"
+
+#define FC_MAX_W ((FFT_MIXED_MAX > FFT_PLAN_MAX) ? FFT_MIXED_MAX : FFT_PLAN_MAX)
+
+// 複素数作業領域 fc_c[FC_H][2 * FC_W]
+// パッキング前は 行の前半 = 実部側, 後半 = 虚部側, パッキング後は (re, im) の交互
+// 面 (bank) は FC_PACKED_BANKS 個まで. fc_c は fc_packed_solve() が使っている面
+static float **fc_c = NULL;
+static float **fc_bank[FC_PACKED_BANKS];
+static float **fc_view[FC_PACKED_BANKS][2];
+static int fc_banks = 0;
+static int fc_max_h = 0;
+static int fc_max_w = 0;
+
+static float *fc_tmp = NULL; // 1行分 (インタリーブ用)
+static float fc_pair[2][2 * FC_MAX_W]; // C の k1 行目と -k1 行目 (SRAM)
+static float *fc_u = NULL;   // x方向の周波数 (列)
+static float *fc_v = NULL;   // y方向の周波数 (行)
+static float *fc_tf = NULL;  // 伝達関数 (alpha, beta) の表 [n1/2 + 1][n2][2]. サイズが変わった時だけ作る
+static int fc_tf_h = 0;
+static int fc_tf_w = 0;
+static fft_plan_t fc_plan;
+static fft_mixed_t fc_mixed[2]; // 2のべき乗でないサイズ用 (0: 列方向 n1, 1: 行方向 n2)
+
+bool init_fc_packed(int height, int width)
+{
+    return init_fc_packed_banks(height, width, 1);
+}
+
+// 作業領域をすべて解放する (再確保の前, 確保失敗時)
+static void fc_packed_free(void)
+{
+    int b;
+
+    for (b = 0; b < FC_PACKED_BANKS; b++)
+    {
+        if (fc_bank[b])
+            free(fc_bank[b][0]);
+        free(fc_bank[b]);
+        free(fc_view[b][0]);
+        free(fc_view[b][1]);
+        fc_bank[b] = NULL;
+        fc_view[b][0] = NULL;
+        fc_view[b][1] = NULL;
+    }
+    free(fc_tmp);
+    free(fc_u);
+    free(fc_v);
+    free(fc_tf);
+    fc_tmp = NULL;
+    fc_u = NULL;
+    fc_v = NULL;
+    fc_tf = NULL;
+    fc_c = NULL;
+    fc_banks = 0;
+    fc_max_h = 0;
+    fc_max_w = 0;
+    fc_tf_h = 0;
+    fc_tf_w = 0;
+}
+
+bool init_fc_packed_banks(int height, int width, int banks)
+{
+    int i, b;
+
+    if (banks < 1 || banks > FC_PACKED_BANKS)
+    {
+        printf("fc_packed: %d banks (max %d)\n", banks, FC_PACKED_BANKS);
+        return false;
+    }
+    if (!fft_plan_init(&fc_plan, height, width) &&
+        !(fft_mixed_init(&fc_mixed[0], height) && fft_mixed_init(&fc_mixed[1], width)))
+    {
+        printf("fc_packed: unsupported size %dx%d\n", height, width);
+        return false;
+    }
+    fc_packed_free();
+    // line buffers and row pointers in SRAM, the spectrum and the banks in PSRAM
+    fc_tmp = (float *)sfe_mem_malloc_fast(sizeof(float) * width, 0);
+    fc_u = (float *)sfe_mem_malloc_fast(sizeof(float) * width, 0);
+    fc_v = (float *)sfe_mem_malloc_fast(sizeof(float) * height, 0);
+    fc_tf = (float *)sfe_mem_malloc_bulk(sizeof(float) * (height / 2 + 1) * width * 2, 0);
+    bool ok = fc_tmp && fc_u && fc_v && fc_tf;
+    for (b = 0; b < banks && ok; b++)
+    {
+        float **rows = (float **)sfe_mem_malloc_fast(sizeof(float *) * height, 0);
+        fc_view[b][0] = (float **)sfe_mem_malloc_fast(sizeof(float *) * height, 0);
+        fc_view[b][1] = (float **)sfe_mem_malloc_fast(sizeof(float *) * height, 0);
+        float *d = (float *)sfe_mem_malloc_bulk(sizeof(float) * height * width * 2, 0);
+        if (!rows || !fc_view[b][0] || !fc_view[b][1] || !d)
+        {
+            free(rows);
+            free(d);
+            ok = false;
+            break;
+        }
+        // fc_bank[b] は行と d がそろってから (fc_packed_free() は fc_bank[b][0] を d として解放する)
+        for (i = 0; i < height; i++)
+        {
+            rows[i] = d + i * width * 2;
+            fc_view[b][0][i] = rows[i];
+            fc_view[b][1][i] = rows[i] + width;
+        }
+        fc_bank[b] = rows;
+    }
+    if (!ok)
+    {
+        printf("fc_packed: allocation failed\n");
+        fc_packed_free();
+        return false;
+    }
+    fc_c = fc_bank[0];
+    fc_banks = banks;
+    fc_max_h = height;
+    fc_max_w = width;
+    return true;
+}
+
+float **fc_packed_view(int which)
+{
+    return fc_packed_bank_view(0, which);
+}
+
+float **fc_packed_bank_view(int bank, int which)
+{
+    if (bank < 0 || bank >= fc_banks)
+        return NULL;
+    return fc_view[bank][which & 1];
+}
+
+// x[0..w) (行の前半) と y[stride..stride+w) を x + i*y の交互に並べ替える
+// 前から書いても y[j] を読む前に上書きすることはない (2j+1 < stride + j)
+static void fc_interleave_row(float *row, int width, int stride)
+{
+    int j;
+
+    for (j = 0; j < width; j++)
+    {
+        fc_tmp[j] = row[j];
+    }
+    for (j = 0; j < width; j++)
+    {
+        float y = row[stride + j];
+        row[2 * j] = fc_tmp[j];
+        row[2 * j + 1] = y;
+    }
+}
+
+// 伝達関数の表を作る (n1 x n2 が前回と同じなら何もしない)
+// Z(k) = i(u P + v Q) / denom, Zh(k) = (Z(k) + conj Z(-k)) / 2 = i(alpha P + beta Q)
+// alpha, beta は k1 = 0 .. n1/2 の行だけ. -k の値は -alpha(k), -beta(k) (符号の反転だけで正確に一致)
+// u, v は matlab の ifftshift(linspace(-pi/2, pi/2, N)). denom(0, 0) = 1
+static void fc_build_tf(int n1, int n2)
+{
+    int i, j;
+    int n1h = n1 >> 1;
+    int n2h = n2 >> 1;
+
+    if (n1 == fc_tf_h && n2 == fc_tf_w)
+    {
+        return;
+    }
+    for (j = 0; j < n2; j++)
+    {
+        fc_u[j] = -M_PI / 2 + M_PI * (float)((j + n2h) % n2) / (float)(n2 - 1);
+    }
+    for (i = 0; i < n1; i++)
+    {
+        fc_v[i] = M_PI / 2 - M_PI * (float)((i + n1h) % n1) / (float)(n1 - 1);
+    }
+    for (i = 0; i <= n1h; i++)
+    {
+        int m1 = (n1 - i) % n1;
+        float *tf = fc_tf + i * n2 * 2;
+        for (j = 0; j < n2; j++)
+        {
+            int m2 = (n2 - j) % n2;
+            float dk = (i == 0 && j == 0) ? 1.0f : fc_u[j] * fc_u[j] + fc_v[i] * fc_v[i];
+            float dm = (m1 == 0 && m2 == 0) ? 1.0f : fc_u[m2] * fc_u[m2] + fc_v[m1] * fc_v[m1];
+            tf[2 * j] = 0.5f * (fc_u[j] / dk - fc_u[m2] / dm);
+            tf[2 * j + 1] = 0.5f * (fc_v[i] / dk - fc_v[m1] / dm);
+        }
+    }
+    fc_tf_h = n1;
+    fc_tf_w = n2;
+}
+
+// 逆変換(rdft2d)の入力 R + iI (= conj(Zh)) を求める
+// Zh は伝達関数を掛けた結果のエルミート部分 (matlab の real(ifft2(Z)) に相当)
+// ck: C の k 行目, cm: C の -k 行目, k2, m2: 列 (m2 = -k2), alpha, beta: 伝達関数 (fc_build_tf())
+static inline void fc_spectrum(const float *ck, const float *cm, int k2, int m2, float alpha, float beta,
+                               bool swap, float *r, float *im)
+{
+    float cr = ck[2 * k2];
+    float ci = ck[2 * k2 + 1];
+    float mr = cm[2 * m2];
+    float mi = cm[2 * m2 + 1];
+
+    // C = A + iB から A = (C(k) + conj C(-k)) / 2, B = (C(k) - conj C(-k)) / 2i
+    float ar = 0.5f * (cr + mr);
+    float ai = 0.5f * (ci - mi);
+    float br = 0.5f * (ci + mi);
+    float bi = 0.5f * (mr - cr);
+    float pr = swap ? br : ar;
+    float pi = swap ? bi : ai;
+    float qr = swap ? ar : br;
+    float qi = swap ? ai : bi;
+
+    float sr = alpha * pr + beta * qr;
+    float si = alpha * pi + beta * qi;
+
+    // Zh = (-si, sr), conj(Zh) = (-si, -sr)
+    *r = -si;
+    *im = -sr;
+}
+
+// rdft2d の入力形式 (fft4f2d.c の rdft2d <case2> を参照) の k1 行目と -k1 行目を作る.
+// 両方とも C の k1 行目と -k1 行目だけから決まるので, 2行を退避してから fc_c の同じ行に上書きする.
+static void fc_pack_rows(int n1, int n2, int k1, bool swap)
+{
+    int j;
+    int m1 = (n1 - k1) & (n1 - 1);
+    int n2h = n2 >> 1;
+    const float *ck = fc_pair[0];
+    const float *cm = (m1 == k1) ? fc_pair[0] : fc_pair[1];
+    const float *tf = fc_tf + k1 * n2 * 2; // k1 行目の (alpha, beta). -k1 行目は -tf[-j]
+    float *dk = fc_c[k1];
+    float *dm = fc_c[m1];
+    float r, im;
+
+    memcpy(fc_pair[0], fc_c[k1], sizeof(float) * 2 * n2);
+    if (m1 != k1)
+    {
+        memcpy(fc_pair[1], fc_c[m1], sizeof(float) * 2 * n2);
+    }
+
+    for (j = 1; j < n2h; j++)
+    {
+        fc_spectrum(ck, cm, j, n2 - j, tf[2 * j], tf[2 * j + 1], swap, &r, &im);
+        dk[2 * j] = r;
+        dk[2 * j + 1] = im;
+        if (m1 != k1)
+        {
+            fc_spectrum(cm, ck, j, n2 - j, -tf[2 * (n2 - j)], -tf[2 * (n2 - j) + 1], swap, &r, &im);
+            dm[2 * j] = r;
+            dm[2 * j + 1] = im;
+        }
+    }
+    fc_spectrum(ck, cm, 0, 0, tf[0], tf[1], swap, &r, &im);
+    dk[0] = r;
+    if (m1 != k1)
+    {
+        dk[1] = im;
+        fc_spectrum(ck, cm, n2h, n2h, tf[2 * n2h], tf[2 * n2h + 1], swap, &r, &im);
+        dm[1] = r;
+        dm[0] = -im;
+    }
+    else
+    {
+        // k1 = 0, n1/2
+        fc_spectrum(ck, cm, n2h, n2h, tf[2 * n2h], tf[2 * n2h + 1], swap, &r, &im);
+        dk[1] = r;
+    }
+}
+
+// 2のべき乗でないサイズ (rdft2d が使えない) の k1 行目と -k1 行目.
+// 列 0 .. n2/2 の conj(Zh) をそのまま複素数で並べる (cdft2d_mixed_real() で n1 n2 倍の深度になる)
+static void fc_mixed_rows(int n1, int n2, int k1, bool swap)
+{
+    int j;
+    int m1 = (n1 - k1) % n1;
+    const float *ck = fc_pair[0];
+    const float *cm = (m1 == k1) ? fc_pair[0] : fc_pair[1];
+    const float *tf = fc_tf + k1 * n2 * 2;
+    float *dk = fc_c[k1];
+    float *dm = fc_c[m1];
+
+    memcpy(fc_pair[0], fc_c[k1], sizeof(float) * 2 * n2);
+    if (m1 != k1)
+    {
+        memcpy(fc_pair[1], fc_c[m1], sizeof(float) * 2 * n2);
+    }
+
+    for (j = 0; j <= (n2 >> 1); j++)
+    {
+        int m2 = (n2 - j) % n2;
+        fc_spectrum(ck, cm, j, m2, tf[2 * j], tf[2 * j + 1], swap, &dk[2 * j], &dk[2 * j + 1]);
+        if (m1 != k1)
+        {
+            fc_spectrum(cm, ck, j, m2, -tf[2 * m2], -tf[2 * m2 + 1], swap, &dm[2 * j], &dm[2 * j + 1]);
+        }
+    }
+}
+
+// 深度を fc_c[i][0 ... width-1] に求める (2 / (n1 n2) のスケールは掛けていない)
+static int32_t fc_packed_solve(int height, int width, float **p, float **q)
+{
+    int i, j, b;
+    int n1 = height;
+    int n2 = width;
+    int n1h = n1 >> 1;
+    bool swap = false;
+    bool mixed = false; // 2のべき乗でない (fft_mixed.h)
+
+    if (fc_banks == 0 || n1 < 4 || n2 < 8 || n1 > fc_max_h || n2 > fc_max_w || (n1 & 1) || (n2 & 1))
+    {
+        return -1;
+    }
+    if (!fft_plan_init(&fc_plan, n1, n2))
+    {
+        if ((fc_mixed[0].n != n1 && !fft_mixed_init(&fc_mixed[0], n1)) ||
+            (fc_mixed[1].n != n2 && !fft_mixed_init(&fc_mixed[1], n2)))
+        {
+            return -1;
+        }
+        mixed = true;
+    }
+
+    // パッキング: fc_c = A + iB
+    // p, q がどれかの面のビューならその面の中で変換する. それ以外は面 0 にコピー
+    for (b = 0; b < fc_banks; b++)
+    {
+        if ((p == fc_view[b][0] && q == fc_view[b][1]) || (p == fc_view[b][1] && q == fc_view[b][0]))
+            break;
+    }
+    fc_c = fc_bank[(b < fc_banks) ? b : 0];
+    if (b < fc_banks)
+    {
+        swap = (p == fc_view[b][1]); // 実部側に q が入っている
+        for (i = 0; i < n1; i++)
+        {
+            fc_interleave_row(fc_c[i], n2, fc_max_w);
+        }
+    }
+    else
+    {
+        for (i = 0; i < n1; i++)
+        {
+            for (j = 0; j < n2; j++)
+            {
+                fc_c[i][2 * j] = p[i][j];
+                fc_c[i][2 * j + 1] = q[i][j];
+            }
+        }
+    }
+
+    fc_build_tf(n1, n2);
+
+    if (mixed)
+    {
+        // 順変換 -> 伝達関数 -> 実数になる変換. rdft2d の出力と同じ n1 n2 / 2 倍にそろえる
+        cdft2d_mixed(&fc_mixed[0], &fc_mixed[1], -1, fc_c);
+        for (i = 0; i <= n1h; i++)
+        {
+            fc_mixed_rows(n1, n2, i, swap);
+        }
+        cdft2d_mixed_real(&fc_mixed[0], &fc_mixed[1], -1, fc_c);
+        for (i = 0; i < n1; i++)
+        {
+            for (j = 0; j < n2; j++)
+            {
+                fc_c[i][j] *= 0.5f;
+            }
+        }
+        return 0;
+    }
+
+    cdft2d_plan(&fc_plan, -1, fc_c);
+
+    // スペクトルを fc_c の中で rdft2d の入力形式に詰め替えて逆変換 (深度用の別の作業領域は不要)
+    for (i = 0; i <= n1h; i++)
+    {
+        fc_pack_rows(n1, n2, i, swap);
+    }
+    rdft2d_plan(&fc_plan, -1, fc_c);
+    return 0;
+}
+
+int32_t fcmethod_packed(int height, int width,
+                        float **p, float **q,
+                        float **dp)
+{
+    if (fc_packed_solve(height, width, p, q) < 0)
+    {
+        return -1;
+    }
+
+    float scale = 2.0f / (float)(height * width);
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            dp[i][j] = fc_c[i][j] * scale;
+        }
+    }
+    return 0;
+}
+
+int32_t fcmethod_packed_half(int height, int width,
+                             float **p, float **q,
+                             half_t **dp)
+{
+    if (fc_packed_solve(height, width, p, q) < 0)
+    {
+        return -1;
+    }
+
+    float scale = 2.0f / (float)(height * width);
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            dp[i][j] = float_to_half(fc_c[i][j] * scale);
+        }
+    }
+    return 0;
+}
+
+half_t **alloc_2d_half(int n1, int n2)
+{
+    half_t **dd = (half_t **)sfe_mem_malloc_fast(sizeof(half_t *) * n1, 0);
+    half_t *d = (half_t *)sfe_mem_malloc_bulk(sizeof(half_t) * n1 * n2, 0);
+
+    if (!dd || !d)
+    {
+        free(dd);
+        free(d);
+        return NULL;
+    }
+    for (int j = 0; j < n1; j++)
+    {
+        dd[j] = d + j * n2;
+    }
+    return dd;
+}
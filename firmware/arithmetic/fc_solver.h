@@ -0,0 +1,53 @@
+#ifndef __FC_SOLVER_H__
+#define __FC_SOLVER_H__
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "fft_plan.h"
+#include "half.h"
+
+// Frankot-Chellappa (p + i*q パッキング版)
+//
+// p, q (実数) を1つの複素数場 p + i*q として cdft2d を1回だけ実行し,
+// 共役対称性で P, Q のスペクトルを分離してから伝達関数を掛け, rdft2d で逆変換する.
+// fcmethod() (image_process.h) と比べて2次元FFTが1回少ない.
+// 伝達関数は matlab/fcmethod.m と同じ (u, v は linspace(-pi/2, pi/2) を ifftshift したもの)
+// 伝達関数 (エルミート対称の半分, (n1/2 + 1) x n2 の alpha, beta) はサイズが変わった時だけ作り,
+// フレーム毎は表を読んで複素数の積和をするだけ.
+
+// 2のべき乗でないサイズ (2^a 3^b 5^c, 640x480 など) は混合基数のFFT (fft_mixed.h) で変換する.
+
+#define FC_PACKED_BANKS (2) // 複素数作業領域の面の数の上限 (面毎に height x width x 8 bytes)
+
+// 作業領域の確保 (最大サイズで1回だけ呼ぶ. 2のべき乗なら FFT_PLAN_MAX, それ以外は FFT_MIXED_MAX 以下)
+bool init_fc_packed(int height, int width);
+
+// 複素数作業領域を banks 面 (<= FC_PACKED_BANKS) 確保する. 伝達関数の表などは共通.
+// 面毎に勾配の入力先になるので, 法線推定で次のフレームを1つの面に書きながら別の面を変換できる
+// (パイプライン, cam.c). fcmethod_packed() 自体は同時に1つのタスクからしか呼べない.
+bool init_fc_packed_banks(int height, int width, int banks);
+
+// 複素数作業領域の実部/虚部の行ポインタ (which: 0 = 実部側, 1 = 虚部側)
+// estimate_*() の出力先にこれを渡すと, fcmethod_packed() はコピー無しでパッキングする.
+// 各行の先頭から width 個が有効 (行の長さは init_fc_packed() の width * 2)
+float **fc_packed_view(int which); // 面 0
+
+// bank 面目のビュー. 確保していない面は NULL
+float **fc_packed_bank_view(int bank, int which);
+
+// input:  p, q: 勾配 (height x width, fc_packed_(bank_)view() か任意の2次元配列. 任意の配列は面 0 にコピーする)
+// output: dp: 深度 (height x width)
+// p, q の内容は破壊される. height, width は2のべき乗か 2^a 3^b 5^c の偶数で init_fc_packed() 以下
+// return: 0 = OK, -1 = サイズ不正 / 未初期化
+int32_t fcmethod_packed(int height, int width,
+                        float **p, float **q,
+                        float **dp);
+
+// fcmethod_packed() と同じ. 深度は16bit浮動小数点 (half.h) で格納する (float の深度マップの半分のサイズ)
+int32_t fcmethod_packed_half(int height, int width,
+                             float **p, float **q,
+                             half_t **dp);
+
+half_t **alloc_2d_half(int n1, int n2);
+
+#endif //__FC_SOLVER_H__
@@ -1,7 +1,10 @@
 #include <stdio.h>
 // #include "pico/stdlib.h"
 #include <float.h>
+#include <string.h>
+#include "pico.h"
 #include "fft4f2d.h"
+#include "sfe_pico_alloc.h"
 
 #define alloc_error_check(p)                          \
     {                                                 \
@@ -22,6 +25,13 @@ void cftfcol(int n1, int n, float **a, float *w);
 void cftfrow(int n, int n2, float **a, float *w);
 void rftbcol(int n1, int n, float **a, int nc, float *c);
 void rftfcol(int n1, int n, float **a, int nc, float *c);
+void rowfft(int n1, int n2, int isgn, float **a, int *ip, float *w);
+
+#if FFT_USE_TILE
+// 列方向FFT用のSRAMタイル (コアごと)
+static float fft_tile_buf[2][FFT_TILE_ROWS * FFT_TILE_COLS];
+static float *fft_tile_rows[2][FFT_TILE_ROWS];
+#endif
 
 int *alloc_1d_int(int n1)
 {
@@ -56,9 +66,10 @@ float **alloc_2d_float(int n1, int n2)
     float **dd, *d;
     int j;
 
-    dd = (float **)malloc(sizeof(float *) * n1);
+    // row pointers are read for every row: SRAM. the data is streamed in rows: PSRAM
+    dd = (float **)sfe_mem_malloc_fast(sizeof(float *) * n1, 0);
     alloc_error_check(dd);
-    d = (float *)malloc(sizeof(float) * n1 * n2);
+    d = (float *)sfe_mem_malloc_bulk(sizeof(float) * n1 * n2, 0);
     alloc_error_check(d);
     dd[0] = d;
     for (j = 1; j < n1; j++)
@@ -389,27 +400,40 @@ void cdft2d(int n1, int n2, int isgn, float **a, int *ip, float *w)
     {
         bitrv2col(n1, n2, ip + 2, a);
     }
-    if (n1 > 2)
-    {
-        bitrv2row(n1, n2, ip + 2, a);
-    }
+    // 行の並べ替え(bitrv2row)は行ごとの変換と順序を入れ替えてよい
     if (isgn < 0)
     {
         cftfcol(n1, n2, a, w);
-        cftfrow(n1, n2, a, w);
     }
     else
     {
         cftbcol(n1, n2, a, w);
-        cftbrow(n1, n2, a, w);
     }
+    rowfft(n1, n2, isgn, a, ip + 2, w);
 }
 
 void rdft2d(int n1, int n2, int isgn, float **a, int *ip, float *w)
 {
+    rdft2d_setup(n1, n2, ip, w);
+    if (isgn < 0)
+    {
+        rdft2d_rowpass(n1, n2, isgn, a, ip + 2, w, 1);
+        rdft2d_colpass(n1, n2, isgn, a, ip + 2, w + ip[0], ip[1], w);
+    }
+    else
+    {
+        rdft2d_colpass(n1, n2, isgn, a, ip + 2, w + ip[0], ip[1], w);
+        rdft2d_rowpass(n1, n2, isgn, a, ip + 2, w, 1);
+    }
+}
 
-    int n, nw, nc, n1h, i, j;
-    float xi;
+// rdft2d を行パス/列パスに分けて2コアで分担するための部品.
+// 順変換は rowpass -> colpass, 逆変換は colpass -> rowpass の順で, 間に同期が必要.
+
+// テーブル(w, ip[0], ip[1])の準備. 分担する前に1回だけ呼ぶ.
+void rdft2d_setup(int n1, int n2, int *ip, float *w)
+{
+    int n, nw, nc;
 
     n = n1 << 1;
     if (n < n2)
@@ -428,66 +452,148 @@ void rdft2d(int n1, int n2, int isgn, float **a, int *ip, float *w)
         nc = n2 >> 2;
         makect(nc, ip, w + nw);
     }
+}
+
+// 列方向(縦)の変換. a の n2 列のうち, 呼び出し側が渡した列範囲だけを処理する.
+// 右半分は a[i] + n2/2 を並べた行ポインタ配列を渡す. edge: 0/1列目を含む側のみ1
+// ipw: bitrv2row の作業領域(コアごとに別にすること)
+void rdft2d_rowpass(int n1, int n2, int isgn, float **a, int *ipw, float *w, int edge)
+{
+    int n1h, i, j;
+    float xi;
+
     n1h = n1 >> 1;
     if (isgn < 0)
     {
-        for (i = 1; i <= n1h - 1; i++)
+        if (edge)
         {
-            j = n1 - i;
-            xi = a[i][0] - a[j][0];
-            a[i][0] += a[j][0];
-            a[j][0] = xi;
-            xi = a[j][1] - a[i][1];
-            a[i][1] += a[j][1];
-            a[j][1] = xi;
+            for (i = 1; i <= n1h - 1; i++)
+            {
+                j = n1 - i;
+                xi = a[i][0] - a[j][0];
+                a[i][0] += a[j][0];
+                a[j][0] = xi;
+                xi = a[j][1] - a[i][1];
+                a[i][1] += a[j][1];
+                a[j][1] = xi;
+            }
         }
-        if (n1 > 2)
+        rowfft(n1, n2, isgn, a, ipw, w);
+    }
+    else
+    {
+        rowfft(n1, n2, isgn, a, ipw, w);
+        if (edge)
         {
-            bitrv2row(n1, n2, ip + 2, a);
+            for (i = 1; i <= n1h - 1; i++)
+            {
+                j = n1 - i;
+                a[j][0] = 0.5 * (a[i][0] - a[j][0]);
+                a[i][0] -= a[j][0];
+                a[j][1] = 0.5 * (a[i][1] + a[j][1]);
+                a[i][1] -= a[j][1];
+            }
         }
-        cftfrow(n1, n2, a, w);
-        for (i = 0; i <= n1 - 1; i++)
+    }
+}
+
+// 行方向(横)の変換. rows 行ぶん(a から)を処理する. 下半分は a + n1/2 を渡す.
+// c: w + ip[0], nc: ip[1] (rdft2d_setup 後の値)
+void rdft2d_colpass(int rows, int n2, int isgn, float **a, int *ipw, float *c, int nc, float *w)
+{
+    int i;
+    float xi;
+
+    if (isgn < 0)
+    {
+        for (i = 0; i <= rows - 1; i++)
         {
             a[i][1] = 0.5 * (a[i][0] - a[i][1]);
             a[i][0] -= a[i][1];
         }
         if (n2 > 4)
         {
-            rftfcol(n1, n2, a, nc, w + nw); // todo: 並列処理
-            bitrv2col(n1, n2, ip + 2, a);
+            rftfcol(rows, n2, a, nc, c);
+            bitrv2col(rows, n2, ipw, a);
         }
-        cftfcol(n1, n2, a, w);
+        cftfcol(rows, n2, a, w);
     }
     else
     {
         if (n2 > 4)
         {
-            bitrv2col(n1, n2, ip + 2, a);
+            bitrv2col(rows, n2, ipw, a);
         }
-        cftbcol(n1, n2, a, w);
+        cftbcol(rows, n2, a, w);
         if (n2 > 4)
         {
-            rftbcol(n1, n2, a, nc, w + nw);
+            rftbcol(rows, n2, a, nc, c);
         }
-        for (i = 0; i <= n1 - 1; i++)
+        for (i = 0; i <= rows - 1; i++)
         {
             xi = a[i][0] - a[i][1];
             a[i][0] += a[i][1];
             a[i][1] = xi;
         }
-        if (n1 > 2)
+    }
+}
+
+// 列方向(縦)の複素FFT: bitrv2row + cftfrow (isgn < 0) / cftbrow
+// FFT_USE_TILE の時は FFT_TILE_COLS 列ずつSRAMのタイル上で変換する
+void rowfft(int n1, int n2, int isgn, float **a, int *ip, float *w)
+{
+#if FFT_USE_TILE
+    if (n1 <= FFT_TILE_ROWS)
+    {
+        int core = get_core_num();
+        float **t = fft_tile_rows[core];
+        int i, j, cols;
+
+        if (t[0] == NULL)
         {
-            bitrv2row(n1, n2, ip + 2, a);
+            for (j = 0; j < FFT_TILE_ROWS; j++)
+            {
+                t[j] = fft_tile_buf[core] + j * FFT_TILE_COLS;
+            }
         }
-        cftbrow(n1, n2, a, w);
-        for (i = 1; i <= n1h - 1; i++)
+        for (i = 0; i < n2; i += FFT_TILE_COLS)
         {
-            j = n1 - i;
-            a[j][0] = 0.5 * (a[i][0] - a[j][0]);
-            a[i][0] -= a[j][0];
-            a[j][1] = 0.5 * (a[i][1] + a[j][1]);
-            a[i][1] -= a[j][1];
+            cols = (n2 - i < FFT_TILE_COLS) ? n2 - i : FFT_TILE_COLS;
+            for (j = 0; j < n1; j++)
+            {
+                memcpy(t[j], a[j] + i, sizeof(float) * cols);
+            }
+            if (n1 > 2)
+            {
+                bitrv2row(n1, cols, ip, t);
+            }
+            if (isgn < 0)
+            {
+                cftfrow(n1, cols, t, w);
+            }
+            else
+            {
+                cftbrow(n1, cols, t, w);
+            }
+            for (j = 0; j < n1; j++)
+            {
+                memcpy(a[j] + i, t[j], sizeof(float) * cols);
+            }
         }
+        return;
+    }
+#endif
+    if (n1 > 2)
+    {
+        bitrv2row(n1, n2, ip, a);
+    }
+    if (isgn < 0)
+    {
+        cftfrow(n1, n2, a, w);
+    }
+    else
+    {
+        cftbrow(n1, n2, a, w);
     }
 }
 
@@ -10,3 +10,15 @@ float **alloc_2d_float(int n1, int n2);
 void free_2d_float(float **dd);
 void cdft2d(int n1, int n2, int isgn, float **a, int *ip, float *w);
 void rdft2d(int n1, int n2, int isgn, float **a, int *ip, float *w);
+
+// 列方向(縦)のFFT (bitrv2row, cftfrow, cftbrow) は a[j][i] を行をまたいで読むため,
+// PSRAM上の配列ではキャッシュが効かない. FFT_TILE_COLS 列ずつSRAMのタイルにコピーして
+// 連続領域で変換し, 書き戻す. タイルはコアごとに1つ (FFTを実行するタスクはコアに固定しておくこと)
+#define FFT_USE_TILE (1)     // 0: 従来通りPSRAM上で直接変換
+#define FFT_TILE_COLS (16)   // 64 bytes / row
+#define FFT_TILE_ROWS (256)  // n1 がこれより大きい時はタイルを使わない
+
+// rdft2d の分割実行 (2コア並列用, fft_helper.c の rdft2d_dual を参照)
+void rdft2d_setup(int n1, int n2, int *ip, float *w);
+void rdft2d_rowpass(int n1, int n2, int isgn, float **a, int *ipw, float *w, int edge);
+void rdft2d_colpass(int rows, int n2, int isgn, float **a, int *ipw, float *c, int nc, float *w);
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 
 #include "fft_helper.h"
+#include "hardware/timer.h"
 // グローバル変数（引数を共有する場合）
 // typedef struct
 // {
@@ -17,6 +18,20 @@ TaskArgs taskArgs;
 TaskHandle_t FFTTaskHandle = NULL;
 TaskHandle_t getCurrentHandle;
 
+// FFTタスクが fcmethod の変換を実行中 (send_notify_to_task から recv_task_end_flag まで)
+static volatile bool fft_task_busy = false;
+
+// rdft2d_half の各パスの実行時間 (fft_helper_get_stats)
+static volatile fft_helper_stats_t fft_half_stats;
+
+// rdft2d_dual の作業領域 (サイズが増えた時だけ確保し直す)
+static float **dual_qh = NULL;
+static int dual_qh_rows = 0;
+static int *dual_ipw = NULL;
+static int dual_ipw_len = 0;
+
+void __real_rdft2d(int n1, int n2, int isgn, float **a, int *ip, float *w);
+
 // RGB565のGreen成分を8bitにスケールアップ
 uint8_t extract_green_from_rgb565(uint16_t rgb565)
 {
@@ -46,6 +61,9 @@ void send_notify_to_task(void)
     // 処理タスクへ通知を送信
 
     printf("Triggering processing task...\n");
+    taskArgs.job = FFT_JOB_WHOLE;
+    taskArgs.caller = xTaskGetCurrentTaskHandle(); // fcmethod を呼んだタスク (深度パイプラインの B)
+    fft_task_busy = true;
     xTaskNotify(FFTTaskHandle, 0, eNoAction);
     return;
 }
@@ -56,11 +74,187 @@ void recv_task_end_flag()
     uint32_t ulNotificationValue = 0; // 初期化
     if (xTaskNotifyWait(0, 0xFFFFFFFF, &ulNotificationValue, portMAX_DELAY) == pdTRUE)
     {
-        if (ulNotificationValue & 0x1)
+        if (ulNotificationValue & FFT_NOTIFY_END)
         {
             printf("Processing completed. Waiting for next trigger...\n");
         }
     }
+    fft_task_busy = false;
+}
+
+// 自タスクへの通知で bits が立つまで待つ
+static void wait_notify_bits(uint32_t bits)
+{
+    uint32_t ulNotificationValue = 0;
+    while (!(ulNotificationValue & bits))
+    {
+        xTaskNotifyWait(0, bits, &ulNotificationValue, portMAX_DELAY);
+    }
+}
+
+// 作業領域の確保. 失敗したら false (1コアで実行する)
+static bool rdft2d_dual_alloc(int n1, int n2)
+{
+    int len = ((n1 > n2) ? n1 : n2) / 2 + 2;
+
+    if (dual_qh_rows < n1)
+    {
+        free(dual_qh);
+        dual_qh = (float **)malloc(sizeof(float *) * n1);
+        dual_qh_rows = (dual_qh == NULL) ? 0 : n1;
+    }
+    if (dual_ipw_len < len)
+    {
+        free(dual_ipw);
+        dual_ipw = (int *)malloc(sizeof(int) * len);
+        dual_ipw_len = (dual_ipw == NULL) ? 0 : len;
+    }
+    return dual_qh != NULL && dual_ipw != NULL;
+}
+
+// 行パスは列の左右半分, 列パスは行の上下半分で分担する.
+// 呼び出し側(左/上半分)とFFTタスク(右/下半分)は1パス目の後に FFT_NOTIFY_PASS で同期する.
+void rdft2d_dual(int n1, int n2, int isgn, float **a, int *ip, float *w)
+{
+    int i;
+    int n1h = n1 >> 1;
+    int n2h = n2 >> 1;
+
+    if (FFTTaskHandle == NULL || fft_task_busy || xTaskGetCurrentTaskHandle() == FFTTaskHandle ||
+        n1 < 4 || n2 < 8 || !rdft2d_dual_alloc(n1, n2))
+    {
+        __real_rdft2d(n1, n2, isgn, a, ip, w);
+        return;
+    }
+
+    // テーブルは分担前に作っておく(以降 ip[0], ip[1], w は読むだけ)
+    rdft2d_setup(n1, n2, ip, w);
+    for (i = 0; i < n1; i++)
+    {
+        dual_qh[i] = a[i] + n2h;
+    }
+
+    taskArgs.hei = n1;
+    taskArgs.wid = n2;
+    taskArgs.q = a;
+    taskArgs.ip = ip;
+    taskArgs.w = w;
+    taskArgs.job = FFT_JOB_HALF;
+    taskArgs.isgn = isgn;
+    taskArgs.qh = dual_qh;
+    taskArgs.ipw = dual_ipw;
+    taskArgs.caller = xTaskGetCurrentTaskHandle();
+    fft_task_busy = true;
+    xTaskNotify(FFTTaskHandle, 0, eNoAction);
+#if FFT_PASS_STATS
+    uint32_t t0 = time_us_32();
+    uint32_t t1, t2;
+#endif
+
+    if (isgn < 0)
+    {
+        rdft2d_rowpass(n1, n2h, isgn, a, ip + 2, w, 1);
+#if FFT_PASS_STATS
+        t1 = time_us_32();
+#endif
+        wait_notify_bits(FFT_NOTIFY_PASS);
+        xTaskNotify(FFTTaskHandle, 0, eNoAction);
+        rdft2d_colpass(n1h, n2, isgn, a, ip + 2, w + ip[0], ip[1], w);
+    }
+    else
+    {
+        rdft2d_colpass(n1h, n2, isgn, a, ip + 2, w + ip[0], ip[1], w);
+#if FFT_PASS_STATS
+        t1 = time_us_32();
+#endif
+        wait_notify_bits(FFT_NOTIFY_PASS);
+        xTaskNotify(FFTTaskHandle, 0, eNoAction);
+        rdft2d_rowpass(n1, n2h, isgn, a, ip + 2, w, 1);
+    }
+#if FFT_PASS_STATS
+    t2 = time_us_32();
+#endif
+    wait_notify_bits(FFT_NOTIFY_END);
+    fft_task_busy = false;
+#if FFT_PASS_STATS
+    // 列方向(縦)のパスが FFT_USE_TILE の対象
+    printf("rdft2d(%d) %dx%d: %s %u us, %s %u us, total %u us\n", isgn, n1, n2,
+           (isgn < 0) ? "column" : "row", t1 - t0,
+           (isgn < 0) ? "row" : "column", t2 - t1, time_us_32() - t0);
+#endif
+}
+
+void __wrap_rdft2d(int n1, int n2, int isgn, float **a, int *ip, float *w)
+{
+    rdft2d_dual(n1, n2, isgn, a, ip, w);
+}
+
+// Image Task (A) は FFTタスクと同じコアで優先度が低いので, FFTタスクが動いている間は実行されない.
+// つまり A は実行可能 (eReady) から待ち状態には移れず, 移れるのは待ち状態から実行可能への変化 (起床) だけ.
+// パスの開始時に実行可能ならパスの間ずっと A を止めている. 開始時に待ち状態で終了時に実行可能なら
+// パスの途中で起床した (止めていたのはその後の分だけで, 起床の時刻は分からない)
+static bool fft_image_task_ready(void)
+{
+    return (imageHandle != NULL) && (eTaskGetState(imageHandle) == eReady);
+}
+
+static void fft_half_account(uint32_t t0, bool a_ready)
+{
+    uint32_t dt = time_us_32() - t0;
+    fft_half_stats.busy_us += dt;
+    if (a_ready)
+        fft_half_stats.a_ready_us += dt;
+    else if (fft_image_task_ready())
+        fft_half_stats.a_woke_us += dt;
+}
+
+void fft_helper_get_stats(fft_helper_stats_t *stats)
+{
+    stats->busy_us = fft_half_stats.busy_us;
+    stats->a_ready_us = fft_half_stats.a_ready_us;
+    stats->a_woke_us = fft_half_stats.a_woke_us;
+}
+
+// FFTタスク側の半分 (rdft2d_dual の右/下半分)
+static void rdft2d_half(void)
+{
+    uint32_t ulNotificationValue;
+    int n1 = taskArgs.hei;
+    int n2 = taskArgs.wid;
+    int isgn = taskArgs.isgn;
+    int n1h = n1 >> 1;
+    int *ip = taskArgs.ip;
+    float *w = taskArgs.w;
+
+    uint32_t t0 = time_us_32();
+    bool a_ready = fft_image_task_ready();
+
+    if (isgn < 0)
+    {
+        rdft2d_rowpass(n1, n2 >> 1, isgn, taskArgs.qh, taskArgs.ipw, w, 0);
+    }
+    else
+    {
+        rdft2d_colpass(n1 - n1h, n2, isgn, taskArgs.q + n1h, taskArgs.ipw, w + ip[0], ip[1], w);
+    }
+    fft_half_account(t0, a_ready);
+
+    // 呼び出し側の1パス目の終了を待つ
+    xTaskNotify(taskArgs.caller, FFT_NOTIFY_PASS, eSetBits);
+    xTaskNotifyWait(0, 0xFFFFFFFF, &ulNotificationValue, portMAX_DELAY);
+
+    t0 = time_us_32();
+    a_ready = fft_image_task_ready();
+    if (isgn < 0)
+    {
+        rdft2d_colpass(n1 - n1h, n2, isgn, taskArgs.q + n1h, taskArgs.ipw, w + ip[0], ip[1], w);
+    }
+    else
+    {
+        rdft2d_rowpass(n1, n2 >> 1, isgn, taskArgs.qh, taskArgs.ipw, w, 0);
+    }
+    fft_half_account(t0, a_ready);
+    xTaskNotify(taskArgs.caller, FFT_NOTIFY_END, eSetBits);
 }
 
 void vProcessingFFTTask(void *pvParameters)
@@ -72,17 +266,38 @@ void vProcessingFFTTask(void *pvParameters)
         // トリガーを待機 (通知を待機)
         if (xTaskNotifyWait(0, 0xFFFFFFFF, &ulNotificationValue, portMAX_DELAY) == pdTRUE)
         {
-            // 引数の取得
-            int height = taskArgs.hei;
-            int width = taskArgs.wid;
-            float **q = taskArgs.q;
-            int *ip = taskArgs.ip;
-            float *w = taskArgs.w;
+            if (taskArgs.job == FFT_JOB_HALF)
+            {
+                rdft2d_half();
+            }
+            else
+            {
+                // 引数の取得
+                int height = taskArgs.hei;
+                int width = taskArgs.wid;
+                float **q = taskArgs.q;
+                int *ip = taskArgs.ip;
+                float *w = taskArgs.w;
 
-            rdft2d(height, width, 1, q, ip, w);
+                __real_rdft2d(height, width, 1, q, ip, w);
 
-            // トリガータスクへ通知を送信
-            xTaskNotify(imageHandle, 0x1, eSetValueWithoutOverwrite);
+                // トリガータスクへ通知を送信
+                xTaskNotify(taskArgs.caller, FFT_NOTIFY_END, eSetValueWithoutOverwrite);
+            }
+#if FFT_STACK_STATS
+            static UBaseType_t stack_free_min = FFT_TASK_STACK_SIZE;
+            UBaseType_t stack_free = uxTaskGetStackHighWaterMark(NULL);
+            if (stack_free < stack_free_min)
+            {
+                stack_free_min = stack_free;
+                printf("FFTTask stack: %u of %u words unused\n", (unsigned)stack_free, (unsigned)FFT_TASK_STACK_SIZE);
+            }
+#endif
         }
     }
+}
+
+UBaseType_t fft_helper_stack_free(void)
+{
+    return (FFTTaskHandle != NULL) ? uxTaskGetStackHighWaterMark(FFTTaskHandle) : 0;
 }
\ No newline at end of file
@@ -16,8 +16,32 @@ typedef struct
     float **q;
     int *ip;
     float *w;
+    // 以下は rdft2d_dual 用 (既存のメンバの後ろに追加すること)
+    int job;            // FFT_JOB_WHOLE / FFT_JOB_HALF
+    int isgn;
+    float **qh;         // q[i] + wid/2 の行ポインタ配列
+    int *ipw;           // FFTタスク側の bitrv2 作業領域
+    TaskHandle_t caller;
 } TaskArgs;
 
+#define FFT_JOB_WHOLE (0) // rdft2d(hei, wid, 1, q, ip, w) を丸ごと実行 (fcmethod)
+#define FFT_JOB_HALF (1)  // rdft2d の行/列パスの半分を実行 (rdft2d_dual)
+
+#define FFT_NOTIFY_END (0x1)  // 処理終了
+#define FFT_NOTIFY_PASS (0x2) // rdft2d_dual: 1パス目終了
+
+#define FFT_PASS_STATS (0) // 1: rdft2d_dual の各パスの時間(呼び出し側)を表示 (FFT_USE_TILE の効果の確認用)
+
+// FFTタスクの優先度. Image Task (A) と同じコアで動くので A より高くし, rdft2d_dual の半分は
+// A と時分割せずに A を横取りする (横取りした時間は fft_helper_get_stats())
+#define FFT_TASK_PRIORITY (tskIDLE_PRIORITY + 3)
+
+// FFTタスクのスタック (words). 呼び出しの最深部は rdft2d -> rdft2d_rowpass -> rowfft -> bitrv2row で約 330 bytes
+// (-fcallgraph-info=su), これに起動時の printf, FPU レジスタ込みのコンテキスト (約 200 bytes) が加わって
+// 約 1.1 KB. 1倍 (2 KB) では余裕が 2倍弱しかないので 2倍にする. 実機では FFT_STACK_STATS で確認すること
+#define FFT_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE * 2)
+#define FFT_STACK_STATS (0) // 1: FFTタスクのスタックの未使用量 (uxTaskGetStackHighWaterMark) が減ったら表示
+
 // 他のソースファイルで定義するタスクハンドルの宣言
 extern TaskArgs taskArgs;
 extern TaskHandle_t FFTTaskHandle;
@@ -44,5 +68,23 @@ uint8_t extract_green_from_rgb565(uint16_t rgb565);
 
 // FFT task
 void vProcessingFFTTask(void *pvParameters);
+
+// rdft2d_dual の FFTタスク側の累積時間 (起動から)
+typedef struct
+{
+    uint32_t busy_us;    // FFTタスクが rdft2d_dual の半分を計算した時間
+    uint32_t a_ready_us; // そのうち開始時に A が実行可能だったパス. この間 A は止まっていた (下限)
+    uint32_t a_woke_us;  // パスの途中で A が起床したパス. 止めていたのはその一部
+                         // (A が止まっていた時間は a_ready_us 以上 a_ready_us + a_woke_us 以下)
+} fft_helper_stats_t;
+
+void fft_helper_get_stats(fft_helper_stats_t *stats);
+
+// FFTタスクのスタックのうち, これまで一度も使われていない量 (words)
+UBaseType_t fft_helper_stack_free(void);
 void send_notify_to_task(void);
 void recv_task_end_flag(void);
+
+// rdft2d を2コアで分担して実行する. FFTタスクが空いていない時は1コアで実行する.
+// リンク時に rdft2d を --wrap しており, rdft2d の呼び出しはすべてここを通る.
+void rdft2d_dual(int n1, int n2, int isgn, float **a, int *ip, float *w);
@@ -0,0 +1,315 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "fft_mixed.h"
+
+// 作業領域 (SRAM). 行の変換は fm_tile[0] と fm_work, 列の変換は fm_tile[c] と fm_work
+static float fm_work[2 * FFT_MIXED_MAX];
+static float fm_tile[FFT_MIXED_TILE][2 * FFT_MIXED_MAX];
+
+#define FM_C3 (0.86602540378443865f) // sin(2pi/3)
+#define FM_C51 (0.30901699437494742f) // cos(2pi/5)
+#define FM_C52 (-0.80901699437494742f) // cos(4pi/5)
+#define FM_S51 (0.95105651629515357f) // sin(2pi/5)
+#define FM_S52 (0.58778525229247313f) // sin(4pi/5)
+
+bool fft_mixed_size_ok(int n)
+{
+    if (n < 2 || n > FFT_MIXED_MAX)
+    {
+        return false;
+    }
+    while (n % 2 == 0)
+        n /= 2;
+    while (n % 3 == 0)
+        n /= 3;
+    while (n % 5 == 0)
+        n /= 5;
+    return n == 1;
+}
+
+bool fft_mixed_init(fft_mixed_t *plan, int n)
+{
+    static const int radix[] = {4, 2, 3, 5};
+    int r = n;
+    int ncur = n;
+    float *w = plan->w;
+
+    if (!fft_mixed_size_ok(n))
+    {
+        return false;
+    }
+    plan->n = n;
+    plan->nf = 0;
+    for (int k = 0; k < 4; k++)
+    {
+        while (r % radix[k] == 0 && plan->nf < FFT_MIXED_MAX_FACTORS)
+        {
+            plan->factor[plan->nf++] = radix[k];
+            r /= radix[k];
+        }
+    }
+
+    // 段 (長さ ncur, 基数 p) の回転因子 exp(-2pi i q u / ncur), q = 0 .. ncur/p - 1, u = 1 .. p - 1
+    // 合計 sum(ncur - ncur/p) = n - 1 個
+    for (int f = 0; f < plan->nf; f++)
+    {
+        int p = plan->factor[f];
+        int m = ncur / p;
+        for (int q = 0; q < m; q++)
+        {
+            for (int u = 1; u < p; u++, w += 2)
+            {
+                double t = -2.0 * M_PI * (double)(q * u) / (double)ncur;
+                w[0] = (float)cos(t);
+                w[1] = (float)sin(t);
+            }
+        }
+        ncur = m;
+    }
+    return true;
+}
+
+// 1段分 (Stockham, 周波数間引き). x: 長さ ncur の列が s 本並んだもの (s 本目の添字が速い)
+// y[r + s(p q + u)] = DFT_p(x[r + s(q + t m)])_u * W^(q u)
+// si: DFT_p の exp(isgn 2pi i / p) の虚部の符号, sg: 回転因子の虚部の符号 (isgn > 0 は共役)
+
+// 出力 u (u >= 1) に回転因子 (wr[u], wi[u]) を掛けて書く
+#define FM_STORE(u, re, im)                                  \
+    {                                                        \
+        float re_ = (re), im_ = (im);                        \
+        b[(u) * sb] = re_ * wr[u] - im_ * wi[u];             \
+        b[(u) * sb + 1] = re_ * wi[u] + im_ * wr[u];         \
+    }
+
+// q の回転因子を読む (内側のループで読み直さないように)
+#define FM_TWIDDLE(p)                        \
+    float wr[p], wi[p];                      \
+    for (int u = 1; u < (p); u++)            \
+    {                                        \
+        wr[u] = w[2 * (u - 1)];              \
+        wi[u] = sg * w[2 * (u - 1) + 1];     \
+    }
+
+static void fm_pass2(int m, int s, const float *w, const float *x, float *y, float sg)
+{
+    int sa = 2 * s * m;
+    int sb = 2 * s;
+
+    for (int q = 0; q < m; q++, w += 2)
+    {
+        const float *a = x + 2 * s * q;
+        float *b = y + 4 * s * q;
+        FM_TWIDDLE(2);
+        for (int r = 0; r < s; r++, a += 2, b += 2)
+        {
+            float r1 = a[0] - a[sa], i1 = a[1] - a[sa + 1];
+            b[0] = a[0] + a[sa];
+            b[1] = a[1] + a[sa + 1];
+            FM_STORE(1, r1, i1);
+        }
+    }
+}
+
+static void fm_pass4(int m, int s, const float *w, const float *x, float *y, float sg, float si)
+{
+    int sa = 2 * s * m;
+    int sb = 2 * s;
+
+    for (int q = 0; q < m; q++, w += 6)
+    {
+        const float *a = x + 2 * s * q;
+        float *b = y + 8 * s * q;
+        FM_TWIDDLE(4);
+        for (int r = 0; r < s; r++, a += 2, b += 2)
+        {
+            float r0 = a[0] + a[2 * sa], i0 = a[1] + a[2 * sa + 1];
+            float r1 = a[0] - a[2 * sa], i1 = a[1] - a[2 * sa + 1];
+            float r2 = a[sa] + a[3 * sa], i2 = a[sa + 1] + a[3 * sa + 1];
+            float r3 = a[sa] - a[3 * sa], i3 = a[sa + 1] - a[3 * sa + 1];
+            // (r3 + i i3) * (si i)
+            float jr = -si * i3, ji = si * r3;
+            b[0] = r0 + r2;
+            b[1] = i0 + i2;
+            FM_STORE(1, r1 + jr, i1 + ji);
+            FM_STORE(2, r0 - r2, i0 - i2);
+            FM_STORE(3, r1 - jr, i1 - ji);
+        }
+    }
+}
+
+static void fm_pass3(int m, int s, const float *w, const float *x, float *y, float sg, float si)
+{
+    int sa = 2 * s * m;
+    int sb = 2 * s;
+
+    for (int q = 0; q < m; q++, w += 4)
+    {
+        const float *a = x + 2 * s * q;
+        float *b = y + 6 * s * q;
+        FM_TWIDDLE(3);
+        for (int r = 0; r < s; r++, a += 2, b += 2)
+        {
+            float tr = a[sa] + a[2 * sa], ti = a[sa + 1] + a[2 * sa + 1];
+            float ur = a[0] - 0.5f * tr, ui = a[1] - 0.5f * ti;
+            float vr = si * FM_C3 * (a[sa] - a[2 * sa]);
+            float vi = si * FM_C3 * (a[sa + 1] - a[2 * sa + 1]);
+            b[0] = a[0] + tr;
+            b[1] = a[1] + ti;
+            FM_STORE(1, ur - vi, ui + vr);
+            FM_STORE(2, ur + vi, ui - vr);
+        }
+    }
+}
+
+static void fm_pass5(int m, int s, const float *w, const float *x, float *y, float sg, float si)
+{
+    int sa = 2 * s * m;
+    int sb = 2 * s;
+
+    for (int q = 0; q < m; q++, w += 8)
+    {
+        const float *a = x + 2 * s * q;
+        float *b = y + 10 * s * q;
+        FM_TWIDDLE(5);
+        for (int r = 0; r < s; r++, a += 2, b += 2)
+        {
+            float t1r = a[sa] + a[4 * sa], t1i = a[sa + 1] + a[4 * sa + 1];
+            float t2r = a[2 * sa] + a[3 * sa], t2i = a[2 * sa + 1] + a[3 * sa + 1];
+            float t3r = a[sa] - a[4 * sa], t3i = a[sa + 1] - a[4 * sa + 1];
+            float t4r = a[2 * sa] - a[3 * sa], t4i = a[2 * sa + 1] - a[3 * sa + 1];
+            float c1r = a[0] + FM_C51 * t1r + FM_C52 * t2r, c1i = a[1] + FM_C51 * t1i + FM_C52 * t2i;
+            float c2r = a[0] + FM_C52 * t1r + FM_C51 * t2r, c2i = a[1] + FM_C52 * t1i + FM_C51 * t2i;
+            float s1r = si * (FM_S51 * t3r + FM_S52 * t4r), s1i = si * (FM_S51 * t3i + FM_S52 * t4i);
+            float s2r = si * (FM_S52 * t3r - FM_S51 * t4r), s2i = si * (FM_S52 * t3i - FM_S51 * t4i);
+            b[0] = a[0] + t1r + t2r;
+            b[1] = a[1] + t1i + t2i;
+            FM_STORE(1, c1r - s1i, c1i + s1r);
+            FM_STORE(2, c2r - s2i, c2i + s2r);
+            FM_STORE(3, c2r + s2i, c2i - s2r);
+            FM_STORE(4, c1r + s1i, c1i - s1r);
+        }
+    }
+}
+
+// a (SRAM) をその場で変換. work: 作業領域
+static void fm_transform(const fft_mixed_t *plan, int isgn, float *a, float *work)
+{
+    float *x = a;
+    float *y = work;
+    const float *w = plan->w;
+    int ncur = plan->n;
+    int s = 1;
+    float sg = (isgn < 0) ? 1.0f : -1.0f;
+    float si = (isgn < 0) ? -1.0f : 1.0f;
+
+    for (int f = 0; f < plan->nf; f++)
+    {
+        int p = plan->factor[f];
+        int m = ncur / p;
+        float *t;
+        if (p == 4)
+            fm_pass4(m, s, w, x, y, sg, si);
+        else if (p == 2)
+            fm_pass2(m, s, w, x, y, sg);
+        else if (p == 3)
+            fm_pass3(m, s, w, x, y, sg, si);
+        else
+            fm_pass5(m, s, w, x, y, sg, si);
+        w += 2 * (ncur / p) * (p - 1);
+        ncur /= p;
+        s *= p;
+        t = x;
+        x = y;
+        y = t;
+    }
+    if (x != a)
+    {
+        memcpy(a, x, sizeof(float) * 2 * plan->n);
+    }
+}
+
+void cdft_mixed(const fft_mixed_t *plan, int isgn, float *a)
+{
+    memcpy(fm_tile[0], a, sizeof(float) * 2 * plan->n);
+    fm_transform(plan, isgn, fm_tile[0], fm_work);
+    memcpy(a, fm_tile[0], sizeof(float) * 2 * plan->n);
+}
+
+// 列 c0 .. c1-1 の変換 (FFT_MIXED_TILE 列ずつSRAMに集める)
+static void fm_columns(const fft_mixed_t *p1, int isgn, float **a, int c0, int c1)
+{
+    int n1 = p1->n;
+
+    for (; c0 < c1; c0 += FFT_MIXED_TILE)
+    {
+        int nc = (c1 - c0 < FFT_MIXED_TILE) ? c1 - c0 : FFT_MIXED_TILE;
+        for (int i = 0; i < n1; i++)
+        {
+            const float *r = a[i] + 2 * c0;
+            for (int c = 0; c < nc; c++)
+            {
+                fm_tile[c][2 * i] = r[2 * c];
+                fm_tile[c][2 * i + 1] = r[2 * c + 1];
+            }
+        }
+        for (int c = 0; c < nc; c++)
+        {
+            fm_transform(p1, isgn, fm_tile[c], fm_work);
+        }
+        for (int i = 0; i < n1; i++)
+        {
+            float *r = a[i] + 2 * c0;
+            for (int c = 0; c < nc; c++)
+            {
+                r[2 * c] = fm_tile[c][2 * i];
+                r[2 * c + 1] = fm_tile[c][2 * i + 1];
+            }
+        }
+    }
+}
+
+void cdft2d_mixed(const fft_mixed_t *p1, const fft_mixed_t *p2, int isgn, float **a)
+{
+    for (int i = 0; i < p1->n; i++)
+    {
+        cdft_mixed(p2, isgn, a[i]);
+    }
+    fm_columns(p1, isgn, a, 0, p2->n);
+}
+
+void cdft2d_mixed_real(const fft_mixed_t *p1, const fft_mixed_t *p2, int isgn, float **a)
+{
+    int n1 = p1->n;
+    int n2 = p2->n;
+    int n2h = n2 >> 1;
+    float *t = fm_tile[0];
+
+    // 列 0 .. n2/2 だけ変換. 各行は共役対称 (C(i, -k2) = conj C(i, k2)) で, 変換すると実数になる
+    fm_columns(p1, isgn, a, 0, n2h + 1);
+
+    // 2行ずつ C(i) + i C(i + 1) として変換すると, 実部が i 行目, 虚部が i + 1 行目になる
+    for (int i = 0; i < n1; i += 2)
+    {
+        const float *c0 = a[i];
+        const float *c1 = a[i + 1];
+        for (int k = 0; k <= n2h; k++)
+        {
+            t[2 * k] = c0[2 * k] - c1[2 * k + 1];
+            t[2 * k + 1] = c0[2 * k + 1] + c1[2 * k];
+        }
+        for (int k = n2h + 1; k < n2; k++)
+        {
+            int m = n2 - k; // conj C(m) + i conj C(m)
+            t[2 * k] = c0[2 * m] + c1[2 * m + 1];
+            t[2 * k + 1] = -c0[2 * m + 1] + c1[2 * m];
+        }
+        fm_transform(p2, isgn, t, fm_work);
+        for (int j = 0; j < n2; j++)
+        {
+            a[i][j] = t[2 * j];
+            a[i + 1][j] = t[2 * j + 1];
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef __FFT_MIXED_H__
+#define __FFT_MIXED_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// 混合基数 (2, 3, 4, 5) の複素FFT
+//
+// rdft2d() / cdft2d() (fft4f2d.c) は2のべき乗のサイズしか扱えないので, センサの 640x480, 320x240 などを
+// そのまま変換する時に使う (次の2のべき乗 1024x512 へのパディングより 2 .. 4 倍軽い).
+//  - n = 2^a 3^b 5^c (FFT_MIXED_MAX 以下)
+//  - Stockham 型 (並べ替え不要). 各段の回転因子はプランに持つ (SRAM, n 個以下)
+//  - 2次元は行 -> 列. 列は FFT_MIXED_TILE 列ずつSRAMに集めて変換する
+// 作業領域は静的なので, 同時に2つのタスクから使わないこと.
+//
+//  fft_mixed_t p1, p2;
+//  fft_mixed_init(&p1, 480);
+//  fft_mixed_init(&p2, 640);
+//  cdft2d_mixed(&p1, &p2, -1, a); // a[480][2 * 640]
+
+#define FFT_MIXED_MAX (640)        // CAM_MODE_MAX_W
+#define FFT_MIXED_MAX_FACTORS (16)
+#define FFT_MIXED_TILE (4)         // 列方向の変換で一度に集める列数 (32 bytes / row)
+
+typedef struct
+{
+    int n;
+    int nf;
+    uint8_t factor[FFT_MIXED_MAX_FACTORS]; // 4, 2, 3, 5 の順
+    float w[2 * FFT_MIXED_MAX];            // 各段の回転因子 exp(-2 pi i q u / n_stage) (u = 1 .. p - 1)
+} fft_mixed_t;
+
+// n が 2^a 3^b 5^c (2 <= n <= FFT_MIXED_MAX) か
+bool fft_mixed_size_ok(int n);
+
+// プランを作る (回転因子の計算). return: false = サイズ不正
+bool fft_mixed_init(fft_mixed_t *plan, int n);
+
+// 1次元. cdft(2 * n, isgn, a, ...) と同じ (a[0...2*n-1], 実部と虚部の交互. スケールなし)
+void cdft_mixed(const fft_mixed_t *plan, int isgn, float *a);
+
+// 2次元. cdft2d(n1, 2 * n2, isgn, a, ...) と同じ. p1: n1 (列方向), p2: n2 (行方向), a[0...n1-1][0...2*n2-1]
+void cdft2d_mixed(const fft_mixed_t *p1, const fft_mixed_t *p2, int isgn, float **a);
+
+// 結果が実数になる2次元の変換 (入力は n1 x n2 のエルミート対称なスペクトル, n1 は偶数).
+// 入力は列 0 ... n2/2 だけ使う. 出力は a[i][0...n2-1] (各行の前半に実数を詰める).
+// 列方向は半分, 行方向は2行を1回で変換するので cdft2d_mixed() の約半分
+void cdft2d_mixed_real(const fft_mixed_t *p1, const fft_mixed_t *p2, int isgn, float **a);
+
+#endif //__FFT_MIXED_H__
@@ -0,0 +1,38 @@
+#include <stdio.h>
+
+#include "fft_plan.h"
+
+bool fft_plan_init(fft_plan_t *plan, int n1, int n2)
+{
+    int n = (n1 > n2) ? n1 : n2;
+
+    if ((n1 & (n1 - 1)) != 0 || (n2 & (n2 - 1)) != 0)
+    {
+        return false;
+    }
+    for (int i = 0; i < FFT_TABLE_NUM; i++)
+    {
+        if (n <= fft_tables[i].n)
+        {
+            plan->n1 = n1;
+            plan->n2 = n2;
+            plan->table = &fft_tables[i];
+            // ip[0], ip[1] がテーブルを指していれば rdft2d() / cdft2d() はテーブルを作り直さない
+            plan->ip[0] = fft_tables[i].nw;
+            plan->ip[1] = fft_tables[i].nc;
+            return true;
+        }
+    }
+    return false;
+}
+
+// テーブルは読むだけなので const を外して渡してよい
+void rdft2d_plan(fft_plan_t *plan, int isgn, float **a)
+{
+    rdft2d(plan->n1, plan->n2, isgn, a, plan->ip, (float *)plan->table->w);
+}
+
+void cdft2d_plan(fft_plan_t *plan, int isgn, float **a)
+{
+    cdft2d(plan->n1, 2 * plan->n2, isgn, a, plan->ip, (float *)plan->table->w);
+}
@@ -0,0 +1,56 @@
+#ifndef __FFT_PLAN_H__
+#define __FFT_PLAN_H__
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "pico.h"
+#include "fft4f2d.h"
+
+// 固定サイズ用のFFTプラン
+//
+// rdft2d() / cdft2d() は初回に makewt() / makect() でテーブル(ip, w)を作るが,
+// プランは gen_fft_tables.py で生成済みのテーブル(fft_tables.c)をそのまま使う.
+// テーブルはSRAMに置く. 起動時の計算とPSRAMからの読み出しが無くなる.
+// (scratch_y は core 0 のスタックと共有なので使わない)
+//
+//  fft_plan_t plan;
+//  fft_plan_init(&plan, 256, 256);
+//  rdft2d_plan(&plan, 1, a);
+
+#define FFT_PLAN_MIN (64)
+#define FFT_PLAN_MAX (512)
+#define FFT_TABLE_NUM (4)   // 64, 128, 256, 512
+#define FFT_PLAN_IP_LEN (40) // 2 + sqrt(2 * FFT_PLAN_MAX) 以上
+
+#define FFT_TABLE_SRAM __not_in_flash("fft_tables")
+
+typedef struct
+{
+    int n;          // n1, n2 <= n のFFTに使える
+    int nw;         // ip[0] (= n / 2)
+    int nc;         // ip[1] (= n / 4)
+    const float *w; // makewt(nw), makect(nc) の結果を続けて並べたもの
+} fft_table_t;
+
+typedef struct
+{
+    int n1;
+    int n2;
+    const fft_table_t *table;
+    int ip[FFT_PLAN_IP_LEN]; // ip[0], ip[1] はテーブルの値. ip + 2 はビット反転の作業領域
+} fft_plan_t;
+
+extern const fft_table_t fft_tables[FFT_TABLE_NUM];
+
+// n1 x n2 (2のべき乗, FFT_PLAN_MIN ... FFT_PLAN_MAX 以下) に合うテーブルを選ぶ.
+// n1, n2 が FFT_PLAN_MIN より小さくてもよい. 合うテーブルが無ければ false
+bool fft_plan_init(fft_plan_t *plan, int n1, int n2);
+
+// rdft2d(n1, n2, isgn, a, ip, w) と同じ (2コア分担も同じく行う)
+// プランの作業領域を使うので, 1つのプランを同時に2つのタスクから使わないこと.
+void rdft2d_plan(fft_plan_t *plan, int isgn, float **a);
+
+// cdft2d(n1, 2 * n2, isgn, a, ip, w) と同じ. a[0...n1-1][0...2*n2-1]
+void cdft2d_plan(fft_plan_t *plan, int isgn, float **a);
+
+#endif //__FFT_PLAN_H__
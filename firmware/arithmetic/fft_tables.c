@@ -0,0 +1,115 @@
+// generated by gen_fft_tables.py. do not edit.
+#include "fft_plan.h"
+
+// n = 64: w[0..32) = makewt(32), w[32..48) = makect(16)
+static const float FFT_TABLE_SRAM fft_w64[48] = {
+    1, 0, 0.707106769, 0.707106769, 0.923879504, 0.382683456, 0.382683456, 0.923879504,
+    0.980785251, 0.195090324, 0.555570245, 0.831469595, 0.831469595, 0.555570245, 0.195090324, 0.980785251,
+    0.99518472, 0.0980171412, 0.634393334, 0.773010433, 0.881921232, 0.471396744, 0.290284663, 0.956940353,
+    0.956940353, 0.290284663, 0.471396744, 0.881921232, 0.773010433, 0.634393334, 0.0980171412, 0.99518472,
+    0.5, 0.49759236, 0.490392625, 0.478470176, 0.461939752, 0.440960616, 0.415734798, 0.386505216,
+    0.353553385, 0.317196667, 0.277785122, 0.235698372, 0.191341728, 0.145142332, 0.0975451618, 0.0490085706,
+};
+
+// n = 128: w[0..64) = makewt(64), w[64..96) = makect(32)
+static const float FFT_TABLE_SRAM fft_w128[96] = {
+    1, 0, 0.707106769, 0.707106769, 0.923879504, 0.382683456, 0.382683456, 0.923879504,
+    0.980785251, 0.195090324, 0.555570245, 0.831469595, 0.831469595, 0.555570245, 0.195090324, 0.980785251,
+    0.99518472, 0.0980171412, 0.634393334, 0.773010433, 0.881921232, 0.471396744, 0.290284663, 0.956940353,
+    0.956940353, 0.290284663, 0.471396744, 0.881921232, 0.773010433, 0.634393334, 0.0980171412, 0.99518472,
+    0.99879545, 0.0490676761, 0.671558976, 0.740951121, 0.903989315, 0.427555084, 0.336889863, 0.941544056,
+    0.970031261, 0.242980197, 0.514102757, 0.857728601, 0.803207517, 0.59569931, 0.146730468, 0.989176512,
+    0.989176512, 0.146730468, 0.59569931, 0.803207517, 0.857728601, 0.514102757, 0.242980197, 0.970031261,
+    0.941544056, 0.336889863, 0.427555084, 0.903989315, 0.740951121, 0.671558976, 0.0490676761, 0.99879545,
+    0.5, 0.499397725, 0.49759236, 0.494588256, 0.490392625, 0.485015631, 0.478470176, 0.470772028,
+    0.461939752, 0.451994658, 0.440960616, 0.4288643, 0.415734798, 0.401603758, 0.386505216, 0.37047556,
+    0.353553385, 0.335779488, 0.317196667, 0.297849655, 0.277785122, 0.257051378, 0.235698372, 0.213777542,
+    0.191341728, 0.168444932, 0.145142332, 0.121490099, 0.0975451618, 0.0733652338, 0.0490085706, 0.024533838,
+};
+
+// n = 256: w[0..128) = makewt(128), w[128..192) = makect(64)
+static const float FFT_TABLE_SRAM fft_w256[192] = {
+    1, 0, 0.707106769, 0.707106769, 0.923879504, 0.382683456, 0.382683456, 0.923879504,
+    0.980785251, 0.195090324, 0.555570245, 0.831469595, 0.831469595, 0.555570245, 0.195090324, 0.980785251,
+    0.99518472, 0.0980171412, 0.634393334, 0.773010433, 0.881921232, 0.471396744, 0.290284663, 0.956940353,
+    0.956940353, 0.290284663, 0.471396744, 0.881921232, 0.773010433, 0.634393334, 0.0980171412, 0.99518472,
+    0.99879545, 0.0490676761, 0.671558976, 0.740951121, 0.903989315, 0.427555084, 0.336889863, 0.941544056,
+    0.970031261, 0.242980197, 0.514102757, 0.857728601, 0.803207517, 0.59569931, 0.146730468, 0.989176512,
+    0.989176512, 0.146730468, 0.59569931, 0.803207517, 0.857728601, 0.514102757, 0.242980197, 0.970031261,
+    0.941544056, 0.336889863, 0.427555084, 0.903989315, 0.740951121, 0.671558976, 0.0490676761, 0.99879545,
+    0.999698818, 0.024541229, 0.689540565, 0.724247098, 0.914209723, 0.40524134, 0.359895051, 0.932992816,
+    0.975702107, 0.219101235, 0.534997642, 0.84485358, 0.817584813, 0.575808227, 0.170961902, 0.985277653,
+    0.992479563, 0.122410677, 0.615231633, 0.78834641, 0.870086968, 0.492898226, 0.266712785, 0.963776052,
+    0.949528158, 0.313681751, 0.449611336, 0.893224299, 0.757208824, 0.653172851, 0.0735645667, 0.997290432,
+    0.997290432, 0.0735645667, 0.653172851, 0.757208824, 0.893224299, 0.449611336, 0.313681751, 0.949528158,
+    0.963776052, 0.266712785, 0.492898226, 0.870086968, 0.78834641, 0.615231633, 0.122410677, 0.992479563,
+    0.985277653, 0.170961902, 0.575808227, 0.817584813, 0.84485358, 0.534997642, 0.219101235, 0.975702107,
+    0.932992816, 0.359895051, 0.40524134, 0.914209723, 0.724247098, 0.689540565, 0.024541229, 0.999698818,
+    0.5, 0.499849409, 0.499397725, 0.498645216, 0.49759236, 0.496239781, 0.494588256, 0.492638826,
+    0.490392625, 0.487851053, 0.485015631, 0.481888026, 0.478470176, 0.474764079, 0.470772028, 0.466496408,
+    0.461939752, 0.457104862, 0.451994658, 0.446612149, 0.440960616, 0.435043484, 0.4288643, 0.42242679,
+    0.415734798, 0.408792406, 0.401603758, 0.394173205, 0.386505216, 0.378604412, 0.37047556, 0.362123549,
+    0.353553385, 0.344770283, 0.335779488, 0.326586425, 0.317196667, 0.307615817, 0.297849655, 0.287904114,
+    0.277785122, 0.267498821, 0.257051378, 0.246449113, 0.235698372, 0.224805668, 0.213777542, 0.20262067,
+    0.191341728, 0.179947525, 0.168444932, 0.156840876, 0.145142332, 0.133356392, 0.121490099, 0.109550618,
+    0.0975451618, 0.0854809508, 0.0733652338, 0.0612053387, 0.0490085706, 0.0367822833, 0.024533838, 0.0122706145,
+};
+
+// n = 512: w[0..256) = makewt(256), w[256..384) = makect(128)
+static const float FFT_TABLE_SRAM fft_w512[384] = {
+    1, 0, 0.707106769, 0.707106769, 0.923879504, 0.382683456, 0.382683456, 0.923879504,
+    0.980785251, 0.195090324, 0.555570245, 0.831469595, 0.831469595, 0.555570245, 0.195090324, 0.980785251,
+    0.99518472, 0.0980171412, 0.634393334, 0.773010433, 0.881921232, 0.471396744, 0.290284663, 0.956940353,
+    0.956940353, 0.290284663, 0.471396744, 0.881921232, 0.773010433, 0.634393334, 0.0980171412, 0.99518472,
+    0.99879545, 0.0490676761, 0.671558976, 0.740951121, 0.903989315, 0.427555084, 0.336889863, 0.941544056,
+    0.970031261, 0.242980197, 0.514102757, 0.857728601, 0.803207517, 0.59569931, 0.146730468, 0.989176512,
+    0.989176512, 0.146730468, 0.59569931, 0.803207517, 0.857728601, 0.514102757, 0.242980197, 0.970031261,
+    0.941544056, 0.336889863, 0.427555084, 0.903989315, 0.740951121, 0.671558976, 0.0490676761, 0.99879545,
+    0.999698818, 0.024541229, 0.689540565, 0.724247098, 0.914209723, 0.40524134, 0.359895051, 0.932992816,
+    0.975702107, 0.219101235, 0.534997642, 0.84485358, 0.817584813, 0.575808227, 0.170961902, 0.985277653,
+    0.992479563, 0.122410677, 0.615231633, 0.78834641, 0.870086968, 0.492898226, 0.266712785, 0.963776052,
+    0.949528158, 0.313681751, 0.449611336, 0.893224299, 0.757208824, 0.653172851, 0.0735645667, 0.997290432,
+    0.997290432, 0.0735645667, 0.653172851, 0.757208824, 0.893224299, 0.449611336, 0.313681751, 0.949528158,
+    0.963776052, 0.266712785, 0.492898226, 0.870086968, 0.78834641, 0.615231633, 0.122410677, 0.992479563,
+    0.985277653, 0.170961902, 0.575808227, 0.817584813, 0.84485358, 0.534997642, 0.219101235, 0.975702107,
+    0.932992816, 0.359895051, 0.40524134, 0.914209723, 0.724247098, 0.689540565, 0.024541229, 0.999698818,
+    0.999924719, 0.0122715384, 0.698376298, 0.715730786, 0.919113874, 0.393992066, 0.371317208, 0.928506076,
+    0.97831738, 0.207111388, 0.545324981, 0.838224709, 0.824589252, 0.565731823, 0.183039889, 0.983105481,
+    0.993906975, 0.110222206, 0.624859512, 0.780737221, 0.876070082, 0.482183754, 0.27851969, 0.960430503,
+    0.953306019, 0.302005947, 0.460538715, 0.887639642, 0.765167236, 0.643831551, 0.0857973173, 0.996312618,
+    0.998118103, 0.0613207407, 0.662415802, 0.749136388, 0.898674488, 0.438616246, 0.32531032, 0.945607305,
+    0.966976464, 0.254865676, 0.50353837, 0.863972843, 0.795836926, 0.60551101, 0.134580716, 0.990902662,
+    0.987301409, 0.15885815, 0.585797906, 0.81045717, 0.851355195, 0.524589717, 0.231058121, 0.972939968,
+    0.937339008, 0.348418683, 0.416429579, 0.909167945, 0.732654274, 0.680601001, 0.0368072242, 0.999322355,
+    0.999322355, 0.0368072242, 0.680601001, 0.732654274, 0.909167945, 0.416429579, 0.348418683, 0.937339008,
+    0.972939968, 0.231058121, 0.524589717, 0.851355195, 0.81045717, 0.585797906, 0.15885815, 0.987301409,
+    0.990902662, 0.134580716, 0.60551101, 0.795836926, 0.863972843, 0.50353837, 0.254865676, 0.966976464,
+    0.945607305, 0.32531032, 0.438616246, 0.898674488, 0.749136388, 0.662415802, 0.0613207407, 0.998118103,
+    0.996312618, 0.0857973173, 0.643831551, 0.765167236, 0.887639642, 0.460538715, 0.302005947, 0.953306019,
+    0.960430503, 0.27851969, 0.482183754, 0.876070082, 0.780737221, 0.624859512, 0.110222206, 0.993906975,
+    0.983105481, 0.183039889, 0.565731823, 0.824589252, 0.838224709, 0.545324981, 0.207111388, 0.97831738,
+    0.928506076, 0.371317208, 0.393992066, 0.919113874, 0.715730786, 0.698376298, 0.0122715384, 0.999924719,
+    0.5, 0.49996236, 0.499849409, 0.499661177, 0.499397725, 0.499059051, 0.498645216, 0.498156309,
+    0.49759236, 0.496953487, 0.496239781, 0.495451331, 0.494588256, 0.493650705, 0.492638826, 0.49155274,
+    0.490392625, 0.48915869, 0.487851053, 0.486469984, 0.485015631, 0.483488232, 0.481888026, 0.480215251,
+    0.478470176, 0.47665301, 0.474764079, 0.472803652, 0.470772028, 0.468669504, 0.466496408, 0.464253038,
+    0.461939752, 0.459556937, 0.457104862, 0.454583973, 0.451994658, 0.449337244, 0.446612149, 0.443819821,
+    0.440960616, 0.438035041, 0.435043484, 0.431986421, 0.4288643, 0.425677598, 0.42242679, 0.419112355,
+    0.415734798, 0.412294626, 0.408792406, 0.405228585, 0.401603758, 0.397918463, 0.394173205, 0.390368611,
+    0.386505216, 0.382583618, 0.378604412, 0.374568194, 0.37047556, 0.366327137, 0.362123549, 0.357865393,
+    0.353553385, 0.349188149, 0.344770283, 0.3403005, 0.335779488, 0.331207901, 0.326586425, 0.321915776,
+    0.317196667, 0.312429756, 0.307615817, 0.302755505, 0.297849655, 0.292898953, 0.287904114, 0.282865912,
+    0.277785122, 0.272662491, 0.267498821, 0.262294859, 0.257051378, 0.251769185, 0.246449113, 0.241091877,
+    0.235698372, 0.230269358, 0.224805668, 0.219308123, 0.213777542, 0.20821479, 0.20262067, 0.196996033,
+    0.191341728, 0.185658604, 0.179947525, 0.174209341, 0.168444932, 0.16265516, 0.156840876, 0.151002973,
+    0.145142332, 0.139259845, 0.133356392, 0.127432838, 0.121490099, 0.11552906, 0.109550618, 0.103555694,
+    0.0975451618, 0.0915199444, 0.0854809508, 0.0794290751, 0.0733652338, 0.0672903582, 0.0612053387, 0.0551111028,
+    0.0490085706, 0.0428986587, 0.0367822833, 0.0306603704, 0.024533838, 0.0184036121, 0.0122706145, 0.00613576919,
+};
+
+const fft_table_t fft_tables[FFT_TABLE_NUM] = {
+    {64, 32, 16, fft_w64},
+    {128, 64, 32, fft_w128},
+    {256, 128, 64, fft_w256},
+    {512, 256, 128, fft_w512},
+};
@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "fused_front.h"
+
+// 直近3ラインの緑 (SRAM). ライン y は win[y % 3]
+static uint8_t win[3][FUSED_FRONT_MAX_W];
+
+// (double)i / 255.0 (estimate_lightsource_and_normal() の輝度の正規化と同じ値)
+static double inv255[256];
+static bool inv255_ready = false;
+
+// extract_green_from_rgb565() と同じ (6bit -> 8bit)
+static inline uint8_t green6to8(uint32_t rgb565)
+{
+    uint8_t green = (rgb565 >> 5) & 0x3F;
+    return (green << 2) | (green >> 4);
+}
+
+// ライン y の緑を抽出. 枠 (zeroPadImageWithBorder() でゼロになる所) はゼロにする
+static void green_line(const fused_front_t *ff, const uint32_t *src, uint8_t *dst, int y)
+{
+    int w = ff->width;
+    int b = ff->border;
+
+    if (y < b || y >= ff->height - b || 2 * b >= w)
+    {
+        memset(dst, 0, w);
+        return;
+    }
+    for (int x = 0; x < w / 2; x++)
+    {
+        uint32_t v = src[x];
+        dst[2 * x] = green6to8(v & 0xFFFF);
+        dst[2 * x + 1] = green6to8(v >> 16);
+    }
+    memset(dst, 0, b);
+    memset(dst + w - b, 0, b);
+}
+
+// 中央のライン m の Sobel 勾配から光源の積算 (x = 1 .. width - 2, ラスタ順)
+// 勾配は整数で正確. |G| が 255 を超える時は 255, |G| = 0 の画素は積算しない
+// 各画素の寄与は (-Gx, -Gy, 1) * I / |G| なので, z 成分は勾配のスケールに依存する
+static void sobel_line(fused_front_t *ff, const uint8_t *t, const uint8_t *m, const uint8_t *b)
+{
+    float sx = ff->sx, sy = ff->sy, sz = ff->sz, si = ff->si;
+    float gs = ff->gscale;
+
+    for (int x = 1; x < ff->width - 1; x++)
+    {
+        int32_t gx = (t[x + 1] - t[x - 1]) + 2 * (m[x + 1] - m[x - 1]) + (b[x + 1] - b[x - 1]);
+        int32_t gy = (b[x - 1] + 2 * b[x] + b[x + 1]) - (t[x - 1] + 2 * t[x] + t[x + 1]);
+        int32_t g2 = gx * gx + gy * gy;
+        if (g2 == 0)
+            continue;
+
+        // sqrtf(g2) = (float)sqrt((double)g2) (g2 < 2^24 なので g2 は float で正確)
+        // gscale = 1 (全解像度) の時は各項の丸めも estimate_lightsource_and_normal() と同じ
+        float mag = (g2 > ff->g2max) ? 255.0f : sqrtf((float)g2) * gs;
+        int32_t i = m[x];
+        sz += (float)i / mag;
+        sx += (float)(-gx * i) * gs / mag;
+        sy += (float)(-gy * i) * gs / mag;
+        si = (float)(inv255[i] + (double)si);
+    }
+    ff->sx = sx;
+    ff->sy = sy;
+    ff->sz = sz;
+    ff->si = si;
+}
+
+bool fused_front_begin(fused_front_t *ff, int height, int width, int border, bool light)
+{
+    if (width > FUSED_FRONT_MAX_W || width < 3 || height < 3)
+    {
+        printf("fused_front: unsupported size %dx%d (width 3 .. %d)\n", height, width, FUSED_FRONT_MAX_W);
+        return false;
+    }
+    if (!inv255_ready)
+    {
+        for (int i = 0; i < 256; i++)
+            inv255[i] = (double)i / 255.0;
+        inv255_ready = true;
+    }
+    ff->height = height;
+    ff->width = width;
+    ff->border = border;
+    ff->row = 0;
+    ff->light = light;
+    ff->gscale = 1.0f;
+    ff->g2max = 255 * 255;
+    ff->sx = 0.0f;
+    ff->sy = 0.0f;
+    ff->sz = 0.0f;
+    ff->si = 0.0f;
+    return true;
+}
+
+void fused_front_rgb565(fused_front_t *ff, const uint32_t *src, int rows, uint8_t *img)
+{
+    int w = ff->width;
+
+    for (int r = 0; r < rows && ff->row < ff->height; r++, src += w / 2)
+    {
+        int y = ff->row++;
+        uint8_t *cur = win[y % 3];
+        green_line(ff, src, cur, y);
+        memcpy(img + y * w, cur, w);
+
+        // ライン y が揃ったので y - 1 の勾配
+        if (ff->light && y >= 2)
+            sobel_line(ff, win[(y - 2) % 3], win[(y - 1) % 3], cur);
+    }
+}
+
+void fused_front_gray(fused_front_t *ff, const uint8_t *src, int rows, uint8_t *img)
+{
+    int w = ff->width;
+    int b = ff->border;
+
+    for (int r = 0; r < rows && ff->row < ff->height; r++, src += w)
+    {
+        int y = ff->row++;
+        uint8_t *cur = win[y % 3];
+        if (y < b || y >= ff->height - b || 2 * b >= w)
+        {
+            memset(cur, 0, w);
+        }
+        else
+        {
+            memset(cur, 0, b);
+            memcpy(cur + b, src + b, w - 2 * b);
+            memset(cur + w - b, 0, b);
+        }
+        if (img)
+            memcpy(img + y * w, cur, w);
+
+        if (ff->light && y >= 2)
+            sobel_line(ff, win[(y - 2) % 3], win[(y - 1) % 3], cur);
+    }
+}
+
+void fused_front_light(const fused_front_t *ff, float *L, float *k)
+{
+    // 光源 (正規化) と係数. estimate_lightsource_and_normal() と同じ演算順 (fma を含む)
+    float n = sqrtf(fmaf(ff->sz, ff->sz, fmaf(ff->sx, ff->sx, ff->sy * ff->sy)));
+    float ly = ff->sy / n;
+    float lz = ff->sz / n;
+    float lx = ff->sx / n;
+    float dot = fmaf(ff->sz, lz, fmaf(ff->sx, lx, ff->sy * ly));
+    L[0] = lx;
+    L[1] = ly;
+    L[2] = lz;
+    *k = ff->si / dot;
+}
+
+void fused_front_finish(fused_front_t *ff, const uint8_t *img,
+                        float **p, float **q, float *L, float *k, normal_lut_t *lut)
+{
+    fused_front_light(ff, L, k);
+
+    // p, q は輝度だけの関数
+    normal_lut_update(lut, L);
+    estimate_normal_lut(ff->height, ff->width, img, p, q, lut);
+}
+
+bool estimate_lightsource_decimated(int height, int width, const uint8_t *img, int step,
+                                    float *L, float *k)
+{
+    static uint16_t acc[FUSED_FRONT_MAX_W];
+    static uint8_t line[FUSED_FRONT_MAX_W];
+    fused_front_t ff;
+    int hd = height / step;
+    int wd = width / step;
+    uint32_t half = (step * step) / 2;
+
+    if (step < 2 || step > FUSED_FRONT_MAX_STEP || !fused_front_begin(&ff, hd, wd, 0, true))
+        return false;
+    // 間引き画像の勾配は元の画素あたりの step 倍
+    ff.gscale = 1.0f / step;
+    ff.g2max = 255 * 255 * step * step;
+
+    // step x step の平均を1ラインずつ (枠は元の画像でゼロ済み)
+    for (int yd = 0; yd < hd; yd++)
+    {
+        memset(acc, 0, wd * sizeof(acc[0]));
+        for (int r = 0; r < step; r++)
+        {
+            const uint8_t *s = img + (yd * step + r) * width;
+            for (int xd = 0; xd < wd; xd++, s += step)
+                for (int c = 0; c < step; c++)
+                    acc[xd] += s[c];
+        }
+        for (int xd = 0; xd < wd; xd++)
+            line[xd] = (acc[xd] + half) / (step * step);
+        fused_front_gray(&ff, line, 1, NULL);
+    }
+    fused_front_light(&ff, L, k);
+    return true;
+}
+
+float mean_intensity_decimated(int height, int width, const uint8_t *img, int step)
+{
+    uint32_t sum = 0;
+    uint32_t n = 0;
+
+    for (int y = step / 2; y < height; y += step)
+    {
+        const uint8_t *s = img + y * width;
+        for (int x = step / 2; x < width; x += step, n++)
+            sum += s[x];
+    }
+    return (n > 0) ? (float)sum / n : 0.0f;
+}
@@ -0,0 +1,64 @@
+#ifndef __FUSED_FRONT_H__
+#define __FUSED_FRONT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "normal_lut.h"
+
+// 前段の融合カーネル (緑抽出 + 枠のゼロ埋め + 勾配/光源推定)
+//
+// extract_green_from_uint32_array() -> zeroPadImageWithBorder() -> estimate_lightsource_and_normal()
+// の3パスを, RGB565 の各ラインを1回だけ読むストリーム処理にまとめたもの.
+//  - 直近3ラインの緑を SRAM の窓に置き, 1ライン遅れで Sobel と光源の積算を行う
+//  - 枠 (border) は抽出時にゼロにする (パディング済み画像を別に作らない)
+//  - 光源 L が決まった後, p = I/255*Lx/Lz, q = I/255*Ly/Lz は輝度だけの関数なので
+//    256要素のテーブル (normal_lut.h) で FFT の入力 (fc_packed_view() など) へ直接書き込む
+// 結果は3段の処理とビット単位で一致する (Sobel は整数, 積算の順序と丸めも同じ).
+// Pico SDK に依存しないのでホストでもビルドできる.
+
+#define FUSED_FRONT_MAX_W (640) // 窓の1ラインの最大幅 (CAM_MODE_MAX_W, FFT_MIXED_MAX)
+#define FUSED_FRONT_MAX_STEP (16) // estimate_lightsource_decimated() の最大の間引き
+
+typedef struct
+{
+    int height;
+    int width;
+    int border;
+    int row;     // 次に入力するライン
+    bool light;  // false: 緑抽出とパディングだけ (光源の積算をしない)
+    float gscale;  // 勾配のスケール (間引き画像では 1/step. 元の画素あたりの勾配にする)
+    int32_t g2max; // |G|^2 の上限 (|G| * gscale = 255)
+    float sx;    // sum(-Gx * I / |G|)
+    float sy;    // sum(-Gy * I / |G|)
+    float sz;    // sum(I / |G|)
+    float si;    // sum(I / 255)
+} fused_front_t;
+
+// フレームの先頭で呼ぶ. return: false = 幅が FUSED_FRONT_MAX_W を超える, 幅か高さが 3 未満
+// light: false なら Sobel と光源の積算を省く (光源を推定しないフレーム用)
+bool fused_front_begin(fused_front_t *ff, int height, int width, int border, bool light);
+
+// RGB565 (2画素/32bit) を rows ライン入力する. ストリップ単位で続けて呼んでもよい.
+// img: 緑画像 (height x width, 枠はゼロ) の出力先. fused_front_finish() で使う
+void fused_front_rgb565(fused_front_t *ff, const uint32_t *src, int rows, uint8_t *img);
+
+// 8bit の画像を rows ライン入力する (枠のゼロ埋めは同じ). img: NULL なら画像は残さない
+void fused_front_gray(fused_front_t *ff, const uint8_t *src, int rows, uint8_t *img);
+
+// 全ライン入力後に呼ぶ. 光源 L と係数 k だけ (estimate_lightsource_and_normal() と同じ値)
+void fused_front_light(const fused_front_t *ff, float *L, float *k);
+
+// 全ライン入力後に呼ぶ. estimate_lightsource_and_normal(height, width, img, p, q, L, k) と同じ出力
+// lut: 推定した L で作り直して p, q に使う
+void fused_front_finish(fused_front_t *ff, const uint8_t *img,
+                        float **p, float **q, float *L, float *k, normal_lut_t *lut);
+
+// 間引き画像 (step x step の平均, step = 2 .. FUSED_FRONT_MAX_STEP) での光源推定.
+// 光源の変化は遅いので, 全画素の推定の代わりに使う. img: height x width (パディング済み)
+bool estimate_lightsource_decimated(int height, int width, const uint8_t *img, int step,
+                                    float *L, float *k);
+
+// 平均輝度 (step x step 毎に1画素を見る)
+float mean_intensity_decimated(int height, int width, const uint8_t *img, int step);
+
+#endif //__FUSED_FRONT_H__
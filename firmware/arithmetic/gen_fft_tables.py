@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+# fft_tables.c の生成スクリプト
+# makewt() / makect() (fft4f2d.c) と同じ計算を float の丸めまで再現して, 固定サイズの cos/sin テーブルを出力する.
+# usage: python3 gen_fft_tables.py > fft_tables.c
+import math
+import struct
+
+SIZES = [64, 128, 256, 512]  # FFT_PLAN_MIN ... FFT_PLAN_MAX
+
+
+def f32(x):
+    return struct.unpack('f', struct.pack('f', x))[0]
+
+
+def bitrv2(n, a):
+    ip = [0] * (n + 2)
+    l = n
+    m = 1
+    while (m << 2) < l:
+        l >>= 1
+        for j in range(m):
+            ip[m + j] = ip[j] + l
+        m <<= 1
+
+    def swap(j1, k1):
+        a[j1], a[k1] = a[k1], a[j1]
+        a[j1 + 1], a[k1 + 1] = a[k1 + 1], a[j1 + 1]
+
+    m2 = m << 1
+    for k in range(1, m):
+        for j in range(k):
+            j1 = (j << 1) + ip[k]
+            k1 = (k << 1) + ip[j]
+            swap(j1, k1)
+            if (m << 2) <= l:
+                swap(j1 + m2, k1 + m2)
+
+
+def makewt(nw):
+    w = [0.0] * nw
+    nwh = nw >> 1
+    delta = f32(math.atan(1.0) / nwh)
+    w[0] = 1.0
+    w[1] = 0.0
+    w[nwh] = f32(math.cos(f32(delta * nwh)))
+    w[nwh + 1] = w[nwh]
+    for j in range(2, nwh - 1, 2):
+        x = f32(math.cos(f32(delta * j)))
+        y = f32(math.sin(f32(delta * j)))
+        w[j] = x
+        w[j + 1] = y
+        w[nw - j] = y
+        w[nw - j + 1] = x
+    bitrv2(nw, w)
+    return w
+
+
+def makect(nc):
+    c = [0.0] * nc
+    nch = nc >> 1
+    delta = f32(math.atan(1.0) / nch)
+    c[0] = 0.5
+    c[nch] = f32(0.5 * math.cos(f32(delta * nch)))
+    for j in range(1, nch):
+        c[j] = f32(0.5 * math.cos(f32(delta * j)))
+        c[nc - j] = f32(0.5 * math.sin(f32(delta * j)))
+    return c
+
+
+def main():
+    print('// generated by gen_fft_tables.py. do not edit.')
+    print('#include "fft_plan.h"')
+    print()
+    for n in SIZES:
+        nw = n >> 1
+        nc = n >> 2
+        t = makewt(nw) + makect(nc)
+        print('// n = %d: w[0..%d) = makewt(%d), w[%d..%d) = makect(%d)' % (n, nw, nw, nw, nw + nc, nc))
+        print('static const float FFT_TABLE_SRAM fft_w%d[%d] = {' % (n, nw + nc))
+        for i in range(0, len(t), 8):
+            print('    ' + ' '.join('%.9g,' % v for v in t[i:i + 8]))
+        print('};')
+        print()
+    print('const fft_table_t fft_tables[FFT_TABLE_NUM] = {')
+    for n in SIZES:
+        print('    {%d, %d, %d, fft_w%d},' % (n, n >> 1, n >> 2, n))
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
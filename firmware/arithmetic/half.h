@@ -0,0 +1,129 @@
+#ifndef __HALF_H__
+#define __HALF_H__
+
+#include <stdint.h>
+#include <string.h>
+
+// 16bit 浮動小数点 (格納用). 演算は float に戻してから行う.
+//  HALF_USE_BF16 = 0: IEEE fp16 (仮数 10bit, 最大 65504)
+//  HALF_USE_BF16 = 1: bfloat16 (仮数 7bit, float と同じ範囲)
+#define HALF_USE_BF16 (0)
+
+typedef uint16_t half_t;
+
+static inline uint32_t half_f2u(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static inline float half_u2f(uint32_t u)
+{
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+#if HALF_USE_BF16
+
+static inline half_t float_to_half(float f)
+{
+    uint32_t u = half_f2u(f);
+    if ((u & 0x7fffffff) > 0x7f800000)
+    {
+        return (half_t)((u >> 16) | 0x40); // NaN
+    }
+    u += 0x7fff + ((u >> 16) & 1); // round to nearest even
+    return (half_t)(u >> 16);
+}
+
+static inline float half_to_float(half_t h)
+{
+    return half_u2f((uint32_t)h << 16);
+}
+
+#elif defined(__ARM_FP16_FORMAT_IEEE)
+
+// VCVTB.F16.F32 / VCVTB.F32.F16
+static inline half_t float_to_half(float f)
+{
+    __fp16 h = (__fp16)f;
+    half_t u;
+    memcpy(&u, &h, sizeof(u));
+    return u;
+}
+
+static inline float half_to_float(half_t u)
+{
+    __fp16 h;
+    memcpy(&h, &u, sizeof(h));
+    return (float)h;
+}
+
+#else
+
+static inline half_t float_to_half(float f)
+{
+    uint32_t u = half_f2u(f);
+    uint32_t sign = (u >> 16) & 0x8000;
+    int32_t e = (int32_t)((u >> 23) & 0xff) - 127 + 15;
+    uint32_t m = u & 0x7fffff;
+
+    if (((u >> 23) & 0xff) == 0xff)
+    {
+        return (half_t)(sign | 0x7c00 | (m ? 0x200 : 0)); // inf, NaN
+    }
+    if (e >= 31)
+    {
+        return (half_t)(sign | 0x7c00); // overflow -> inf
+    }
+    if (e <= 0)
+    {
+        // subnormal (or 0)
+        if (e < -10)
+        {
+            return (half_t)sign;
+        }
+        m |= 0x800000;
+        uint32_t sh = (uint32_t)(14 - e);
+        uint32_t h = m >> sh;
+        uint32_t rem = m & ((1u << sh) - 1);
+        uint32_t halfway = 1u << (sh - 1);
+        if (rem > halfway || (rem == halfway && (h & 1)))
+        {
+            h++;
+        }
+        return (half_t)(sign | h);
+    }
+    uint32_t h = ((uint32_t)e << 10) | (m >> 13);
+    uint32_t rem = m & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+    {
+        h++; // carry into the exponent is correct (up to inf)
+    }
+    return (half_t)(sign | h);
+}
+
+static inline float half_to_float(half_t h)
+{
+    uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    uint32_t e = (h >> 10) & 0x1f;
+    uint32_t m = h & 0x3ff;
+
+    if (e == 0x1f)
+    {
+        return half_u2f(sign | 0x7f800000 | (m << 13));
+    }
+    if (e == 0)
+    {
+        // subnormal: m * 2^-24
+        float f = (float)m * (1.0f / 16777216.0f);
+        return sign ? -f : f;
+    }
+    return half_u2f(sign | ((e - 15 + 127) << 23) | (m << 13));
+}
+
+#endif
+
+#endif //__HALF_H__
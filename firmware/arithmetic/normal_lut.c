@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "image_process.h"
+#include "normal_lut.h"
+
+bool normal_lut_update(normal_lut_t *lut, const float *L)
+{
+    if (lut->valid && memcmp(lut->L, L, sizeof(lut->L)) == 0)
+        return false;
+
+    memcpy(lut->L, L, sizeof(lut->L));
+    for (int i = 0; i < 256; i++)
+    {
+        lut->p[i] = (float)((double)i / 255.0 * (double)L[0] / (double)L[2]);
+        lut->q[i] = (float)((double)i / 255.0 * (double)L[1] / (double)L[2]);
+    }
+    lut->valid = true;
+#if (NORMAL_LUT_CHECK)
+    printf("normal lut: L = (%f, %f, %f), max error = %e\n", L[0], L[1], L[2], normal_lut_error(lut));
+#endif
+    return true;
+}
+
+void estimate_normal_lut(int height, int width, const unsigned char *img_gray,
+                         float **p, float **q, const normal_lut_t *lut)
+{
+    for (int y = 0; y < height; y++, img_gray += width)
+    {
+        float *pp = p[y];
+        float *qq = q[y];
+        for (int x = 0; x < width; x++)
+        {
+            pp[x] = lut->p[img_gray[x]];
+            qq[x] = lut->q[img_gray[x]];
+        }
+    }
+}
+
+float normal_lut_error(const normal_lut_t *lut)
+{
+    static unsigned char ramp[256];
+    static float rp[256], rq[256];
+    float *p = rp, *q = rq;
+    float err = 0.0f;
+
+    for (int i = 0; i < 256; i++)
+        ramp[i] = i;
+    // 1 x 256 の画像として全ての輝度を通す
+    estimate_normal(1, 256, ramp, &p, &q, (float *)lut->L);
+    for (int i = 0; i < 256; i++)
+    {
+        err = fmaxf(err, fabsf(rp[i] - lut->p[i]));
+        err = fmaxf(err, fabsf(rq[i] - lut->q[i]));
+    }
+    return err;
+}
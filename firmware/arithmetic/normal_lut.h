@@ -0,0 +1,33 @@
+#ifndef __NORMAL_LUT_H__
+#define __NORMAL_LUT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 光源 L が固定の時の法線推定 (テーブル版 estimate_normal())
+//
+// estimate_normal() の p = I/255*Lx/Lz, q = I/255*Ly/Lz は8bitの輝度 I だけの関数なので,
+// L が変わった時だけ256要素のテーブルを作り, 画素ごとにはテーブルを引くだけにする.
+// テーブルの値は estimate_normal() と同じ演算 (double) で作るので結果は一致する.
+
+#define NORMAL_LUT_CHECK (0) // 1: テーブルを作り直した時に normal_lut_error() を表示する
+
+typedef struct
+{
+    float L[3];   // テーブルを作った時の光源
+    bool valid;
+    float p[256]; // I -> p
+    float q[256]; // I -> q
+} normal_lut_t;
+
+// L がテーブルと違えば作り直す. return: true = 作り直した
+bool normal_lut_update(normal_lut_t *lut, const float *L);
+
+// estimate_normal(height, width, img_gray, p, q, lut->L) と同じ出力
+void estimate_normal_lut(int height, int width, const unsigned char *img_gray,
+                         float **p, float **q, const normal_lut_t *lut);
+
+// テーブルと estimate_normal() (float/double の演算) との差の最大値 (I = 0..255 の全て)
+float normal_lut_error(const normal_lut_t *lut);
+
+#endif //__NORMAL_LUT_H__
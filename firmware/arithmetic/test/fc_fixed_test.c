@@ -0,0 +1,73 @@
+// fcmethod_fixed() (Q31) と fcmethod_packed() (float) の誤差の確認
+//
+// 球面の勾配 (+ 雑音) を両方で解いて, 深度の最大誤差と RMS 誤差を float 側の深度の最大値で割ったものを
+// FC_FIXED_BUDGET_MAX / FC_FIXED_BUDGET_RMS と比べる. 超えたら 1 を返す.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fc_solver.h"
+#include "fc_fixed.h"
+
+#define FC_FIXED_BUDGET_MAX (2e-4) // 最大誤差 / max|d|
+#define FC_FIXED_BUDGET_RMS (1e-4) // RMS 誤差 / max|d|
+
+static const int sizes[][2] = {{64, 64}, {64, 128}, {128, 128}, {256, 256}};
+
+static bool check(int height, int width)
+{
+    if (!init_fc_packed(height, width) || !init_fc_fixed(height, width))
+        return false;
+    float **pv = fc_packed_view(0), **qv = fc_packed_view(1);
+    float **xp = fc_fixed_view(0), **xq = fc_fixed_view(1);
+    float **d = alloc_2d_float(height, width);
+    q15_t **dq = alloc_2d_q15(height, width);
+    srand(height * 1000 + width);
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            float x = (j - width / 2) / (float)(width / 3), y = (i - height / 2) / (float)(height / 3);
+            float r2 = x * x + y * y, gp = 0.0f, gq = 0.0f;
+            if (r2 < 0.95f)
+            {
+                float z = sqrtf(1.0f - r2);
+                gp = -x / z;
+                gq = -y / z;
+            }
+            gp += 0.01f * (rand() % 100 - 50) / 50.0f;
+            pv[i][j] = xp[i][j] = gp;
+            qv[i][j] = xq[i][j] = gq;
+        }
+    }
+    int32_t exp;
+    fcmethod_packed(height, width, pv, qv, d);
+    fcmethod_fixed(height, width, xp, xq, dq, &exp);
+
+    double emax = 0.0, dmax = 0.0, sq = 0.0;
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            double e = ldexp(dq[i][j], exp) - d[i][j];
+            emax = fmax(emax, fabs(e));
+            dmax = fmax(dmax, fabs(d[i][j]));
+            sq += e * e;
+        }
+    }
+    double rel_max = emax / dmax, rel_rms = sqrt(sq / (height * width)) / dmax;
+    bool ok = (rel_max <= FC_FIXED_BUDGET_MAX && rel_rms <= FC_FIXED_BUDGET_RMS);
+    printf("%3dx%-3d max %.2e rms %.2e (budget %.0e / %.0e) %s\n", height, width, rel_max, rel_rms,
+           FC_FIXED_BUDGET_MAX, FC_FIXED_BUDGET_RMS, ok ? "ok" : "NG");
+    free_2d_float(d);
+    free(dq[0]);
+    free(dq);
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++)
+        ok = check(sizes[k][0], sizes[k][1]) && ok;
+    return ok ? 0 : 1;
+}
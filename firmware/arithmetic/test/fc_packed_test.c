@@ -0,0 +1,253 @@
+// fcmethod_packed() / fcmethod_packed_half() と matlab/fcmethod.m (packed = false) の比較
+//
+// 参照は double で fft2(dx), fft2(dy) を別々に求め (行, 列の順の DFT), 伝達関数を掛けて real(ifft2(Z)) をとる.
+// パッキングしたスペクトルの分離と伝達関数の表を独立に確かめるため, 参照は fc_solver.c の関数を使わない.
+// 深度の最大誤差と RMS 誤差を参照の深度の最大値で割ったものを予算と比べる. 超えたら 1 を返す.
+// 2のべき乗 (fft_plan.h) と 2^a 3^b 5^c (fft_mixed.h) のサイズ, 入力は任意の配列 (面 0 にコピー),
+// fc_packed_view() (コピー無し) と実部/虚部を入れ替えたビューの3通り.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fc_solver.h"
+
+#define FC_PACKED_BUDGET_MAX (1e-4) // 最大誤差 / max|d|
+#define FC_PACKED_BUDGET_RMS (2e-5) // RMS 誤差 / max|d|
+// 16bit の深度は丸めの分だけ増やす. 最近接丸めの誤差は |x| の 2^-(仮数のビット数 + 1) 以下
+#if HALF_USE_BF16
+#define FC_HALF_ROUND (1.0 / 256.0)
+#else
+#define FC_HALF_ROUND (1.0 / 2048.0)
+#endif
+#define FC_HALF_BUDGET_MAX (FC_PACKED_BUDGET_MAX + FC_HALF_ROUND)
+#define FC_HALF_BUDGET_RMS (FC_PACKED_BUDGET_RMS + FC_HALF_ROUND / 2)
+
+enum
+{
+    INPUT_COPY = 0, // 任意の2次元配列
+    INPUT_VIEW,     // fc_packed_view(0), fc_packed_view(1)
+    INPUT_SWAPPED,  // p を虚部側, q を実部側のビューに
+};
+
+static const int sizes[][2] = {
+    {64, 64}, {64, 128}, {128, 64}, {256, 256}, // 2のべき乗
+    {48, 80}, {120, 160}, {240, 320}, {480, 640}, // 2^a 3^b 5^c
+};
+
+// 1次元 DFT (double). sign = -1: fft, +1: ifft (1/n は掛けない). x[k * stride] の re, im
+// wc, ws: cos, sin(2 pi m / n) の表, tr, ti: n 個の作業領域
+static void dft(double *re, double *im, int n, int stride, int sign, const double *wc, const double *ws,
+                double *tr, double *ti)
+{
+    for (int k = 0; k < n; k++)
+    {
+        double sr = 0.0, si = 0.0;
+        int km = 0; // k * m mod n
+        for (int m = 0; m < n; m++)
+        {
+            double c = wc[km], s = sign * ws[km];
+            sr += re[m * stride] * c - im[m * stride] * s;
+            si += re[m * stride] * s + im[m * stride] * c;
+            km += k;
+            if (km >= n)
+                km -= n;
+        }
+        tr[k] = sr;
+        ti[k] = si;
+    }
+    for (int k = 0; k < n; k++)
+    {
+        re[k * stride] = tr[k];
+        im[k * stride] = ti[k];
+    }
+}
+
+// 2次元 DFT (n1 行 x n2 列, 行優先)
+static void dft2(double *re, double *im, int n1, int n2, int sign)
+{
+    int n = (n1 > n2) ? n1 : n2;
+    double *tr = malloc(sizeof(double) * n), *ti = malloc(sizeof(double) * n);
+    double *wc = malloc(sizeof(double) * n), *ws = malloc(sizeof(double) * n);
+
+    for (int m = 0; m < n2; m++)
+    {
+        wc[m] = cos(2.0 * M_PI * m / n2);
+        ws[m] = sin(2.0 * M_PI * m / n2);
+    }
+    for (int i = 0; i < n1; i++)
+        dft(re + i * n2, im + i * n2, n2, 1, sign, wc, ws, tr, ti);
+    for (int m = 0; m < n1; m++)
+    {
+        wc[m] = cos(2.0 * M_PI * m / n1);
+        ws[m] = sin(2.0 * M_PI * m / n1);
+    }
+    for (int j = 0; j < n2; j++)
+        dft(re + j, im + j, n1, n2, sign, wc, ws, tr, ti);
+    free(tr);
+    free(ti);
+    free(wc);
+    free(ws);
+}
+
+// matlab/fcmethod.m (high_res = false, packed = false)
+static void fcmethod_ref(int n1, int n2, const double *dx, const double *dy, double *depth)
+{
+    size_t len = (size_t)n1 * n2;
+    double *xr = malloc(sizeof(double) * len), *xi = calloc(len, sizeof(double));
+    double *yr = malloc(sizeof(double) * len), *yi = calloc(len, sizeof(double));
+    double *u = malloc(sizeof(double) * n2), *v = malloc(sizeof(double) * n1);
+
+    for (size_t k = 0; k < len; k++)
+    {
+        xr[k] = dx[k];
+        yr[k] = dy[k];
+    }
+    dft2(xr, xi, n1, n2, -1);
+    dft2(yr, yi, n1, n2, -1);
+
+    // [u, v] = meshgrid(linspace(-pi/2, pi/2, N), linspace(pi/2, -pi/2, M)) を ifftshift
+    for (int j = 0; j < n2; j++)
+        u[j] = -M_PI / 2 + M_PI * ((j + n2 / 2) % n2) / (n2 - 1);
+    for (int i = 0; i < n1; i++)
+        v[i] = M_PI / 2 - M_PI * ((i + n1 / 2) % n1) / (n1 - 1);
+
+    // Z = (1i * u .* FDX + 1i * v .* FDY) ./ denom. 結果は xr, xi に
+    for (int i = 0; i < n1; i++)
+    {
+        for (int j = 0; j < n2; j++)
+        {
+            size_t k = (size_t)i * n2 + j;
+            double denom = (i == 0 && j == 0) ? 1.0 : u[j] * u[j] + v[i] * v[i];
+            double zr = -(u[j] * xi[k] + v[i] * yi[k]) / denom;
+            double zi = (u[j] * xr[k] + v[i] * yr[k]) / denom;
+            xr[k] = zr;
+            xi[k] = zi;
+        }
+    }
+    dft2(xr, xi, n1, n2, +1);
+    for (size_t k = 0; k < len; k++)
+        depth[k] = xr[k] / (double)len;
+
+    free(xr);
+    free(xi);
+    free(yr);
+    free(yi);
+    free(u);
+    free(v);
+}
+
+static bool report(const char *name, int height, int width, int input, const double *ref, double dmax,
+                   float **d, half_t **dh, double budget_max, double budget_rms)
+{
+    static const char *inputs[] = {"copy", "view", "swapped"};
+    double emax = 0.0, sq = 0.0;
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            double x = d ? d[i][j] : half_to_float(dh[i][j]);
+            double e = x - ref[(size_t)i * width + j];
+            emax = fmax(emax, fabs(e));
+            sq += e * e;
+        }
+    }
+    double rel_max = emax / dmax, rel_rms = sqrt(sq / (height * width)) / dmax;
+    bool ok = (rel_max <= budget_max && rel_rms <= budget_rms);
+    printf("%-5s %3dx%-3d %-7s max %.2e rms %.2e (budget %.1e / %.1e) %s\n", name, height, width, inputs[input],
+           rel_max, rel_rms, budget_max, budget_rms, ok ? "ok" : "NG");
+    return ok;
+}
+
+static bool check(int height, int width)
+{
+    if (!init_fc_packed(height, width))
+    {
+        printf("%3dx%-3d init_fc_packed failed\n", height, width);
+        return false;
+    }
+    size_t len = (size_t)height * width;
+    double *gp = malloc(sizeof(double) * len), *gq = malloc(sizeof(double) * len);
+    double *ref = malloc(sizeof(double) * len);
+    float **p = alloc_2d_float(height, width), **q = alloc_2d_float(height, width);
+    float **d = alloc_2d_float(height, width);
+    half_t **dh = alloc_2d_half(height, width);
+
+    // 球面の勾配 + 雑音 (fc_fixed_test.c と同じ)
+    srand(height * 1000 + width);
+    for (int i = 0; i < height; i++)
+    {
+        for (int j = 0; j < width; j++)
+        {
+            float x = (j - width / 2) / (float)(width / 3), y = (i - height / 2) / (float)(height / 3);
+            float r2 = x * x + y * y, vp = 0.0f, vq = 0.0f;
+            if (r2 < 0.95f)
+            {
+                float z = sqrtf(1.0f - r2);
+                vp = -x / z;
+                vq = -y / z;
+            }
+            vp += 0.01f * (rand() % 100 - 50) / 50.0f;
+            gp[(size_t)i * width + j] = vp;
+            gq[(size_t)i * width + j] = vq;
+        }
+    }
+    fcmethod_ref(height, width, gp, gq, ref);
+    double dmax = 0.0;
+    for (size_t k = 0; k < len; k++)
+        dmax = fmax(dmax, fabs(ref[k]));
+
+    bool ok = true;
+    for (int input = INPUT_COPY; input <= INPUT_SWAPPED; input++)
+    {
+        for (int half = 0; half < 2; half++)
+        {
+            // fcmethod_packed*() は p, q を壊すので毎回入れ直す
+            float **pv = p, **qv = q;
+            if (input == INPUT_VIEW)
+            {
+                pv = fc_packed_view(0);
+                qv = fc_packed_view(1);
+            }
+            else if (input == INPUT_SWAPPED)
+            {
+                pv = fc_packed_view(1);
+                qv = fc_packed_view(0);
+            }
+            for (int i = 0; i < height; i++)
+            {
+                for (int j = 0; j < width; j++)
+                {
+                    pv[i][j] = (float)gp[(size_t)i * width + j];
+                    qv[i][j] = (float)gq[(size_t)i * width + j];
+                }
+            }
+            if (half)
+            {
+                ok = (fcmethod_packed_half(height, width, pv, qv, dh) == 0) && ok;
+                ok = report("half", height, width, input, ref, dmax, NULL, dh, FC_HALF_BUDGET_MAX, FC_HALF_BUDGET_RMS) && ok;
+            }
+            else
+            {
+                ok = (fcmethod_packed(height, width, pv, qv, d) == 0) && ok;
+                ok = report("float", height, width, input, ref, dmax, d, NULL, FC_PACKED_BUDGET_MAX, FC_PACKED_BUDGET_RMS) && ok;
+            }
+        }
+    }
+
+    free(gp);
+    free(gq);
+    free(ref);
+    free_2d_float(p);
+    free_2d_float(q);
+    free_2d_float(d);
+    free(dh[0]);
+    free(dh);
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+    for (size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++)
+        ok = check(sizes[k][0], sizes[k][1]) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+// fused_front_*() と3段の処理 (緑抽出 -> zeroPadImageWithBorder() -> estimate_lightsource_and_normal())
+// がビット単位で一致するかの確認
+//
+// 3段の処理は libimage_process.a にしか無いので, ここに書き写したもの (ref_*) と比べる.
+// 入力は乱数 / 滑らかな濃淡 / 濃淡 + 黒い市松模様. ストリップの行数は乱数 (1 .. 37 行) で分ける.
+// 緑画像, L, k, p, q のどれかが1ビットでも違えば 1 を返す.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include "fused_front.h"
+
+#define BORDER (10) // CAM_PAD_BORDER
+
+static const int sizes[][2] = {{64, 64}, {128, 128}, {128, 256}, {256, 256}, {512, 512}, {480, 640}};
+
+// extract_green_from_uint32_array() の1画素 (G6 -> 8bit)
+static uint8_t ref_green(uint16_t v)
+{
+    uint8_t g = (v >> 5) & 0x3f;
+    return (g << 2) | (g >> 4);
+}
+
+// zeroPadImageWithBorder(in, out, w, h, 1, border)
+static void ref_pad(const uint8_t *in, uint8_t *out, int w, int h, int border)
+{
+    memset(out, 0, w * h);
+    for (int y = border; y < h - border; y++)
+        for (int x = border; x < w - border; x++)
+            out[y * w + x] = in[y * w + x];
+}
+
+// estimate_lightsource_and_normal() (演算の順序と丸めも元のまま)
+static void ref_estimate(int h, int w, const uint8_t *img, float **p, float **q, float *L, float *k)
+{
+    float Lx = 0, Ly = 0, Lz = 0, z = 0, si = 0;
+    for (int y = 1; y < h - 1; y++)
+    {
+        for (int x = 1; x < w - 1; x++)
+        {
+            const uint8_t *t = img + (y - 1) * w, *m = img + y * w, *b = img + (y + 1) * w;
+            float s13 = (float)(-t[x - 1]);
+            float s11 = (float)(-2 * t[x]);
+            float s8 = (float)t[x + 1];
+            float s14 = (float)(-2 * m[x - 1]);
+            float s15 = (float)(-t[x + 1]);
+            s13 = s13 + z;
+            s11 = s11 + s13;
+            s13 = s8 + s13;
+            s15 = s15 + s11;
+            s14 = s14 + s13;
+            float s9 = (float)b[x - 1], s12 = (float)(2 * m[x + 1]);
+            s14 = s14 + z;
+            s15 = s15 + z;
+            float s13b = s9 + s15;
+            float s15b = s12 + s14;
+            float s16 = (float)(-b[x - 1]), s17 = (float)(2 * b[x]), s10 = (float)b[x + 1];
+            s17 = s17 + s13b;
+            s16 = s16 + s15b;
+            s17 = s17 + s10;
+            s16 = s16 + z;
+            float a = s17 * s17;
+            s16 = s16 + s10;
+            a = fmaf(s16, s16, a);
+            p[y][x] = s16;
+            q[y][x] = s17;
+            float mag = (float)sqrt((double)a);
+            if (mag > 255.0f)
+                mag = 255.0f;
+            else if (fabsf(mag) == 0)
+                continue;
+            float I = (float)m[x];
+            float n16 = -(s16 * I), n17 = -(s17 * I);
+            Lz += I / mag;
+            Lx += n16 / mag;
+            Ly += n17 / mag;
+            si = (float)((double)m[x] / 255.0 + (double)si);
+        }
+    }
+    float n = (float)sqrt((double)fmaf(Lz, Lz, fmaf(Lx, Lx, Ly * Ly)));
+    float ly = Ly / n, lz = Lz / n, lx = Lx / n;
+    float d = fmaf(Lz, lz, fmaf(Lx, lx, Ly * ly));
+    L[0] = lx;
+    L[1] = ly;
+    L[2] = lz;
+    *k = si / d;
+    for (int y = 0; y < h; y++)
+    {
+        for (int x = 0; x < w; x++)
+        {
+            int I = img[y * w + x];
+            p[y][x] = (float)((double)I / 255.0 * (double)L[0] / (double)L[2]);
+            q[y][x] = (float)((double)I / 255.0 * (double)L[1] / (double)L[2]);
+        }
+    }
+}
+
+static float **alloc_rows(int h, int w)
+{
+    float **r = malloc(h * sizeof(float *));
+    for (int i = 0; i < h; i++)
+        r[i] = calloc(w, sizeof(float));
+    return r;
+}
+
+static void free_rows(float **r, int h)
+{
+    for (int i = 0; i < h; i++)
+        free(r[i]);
+    free(r);
+}
+
+static void make_frame(uint32_t *src, int h, int w, int pattern)
+{
+    for (int i = 0; i < h * w / 2; i++)
+    {
+        if (pattern == 0)
+        {
+            src[i] = (uint32_t)rand() ^ ((uint32_t)rand() << 16);
+            continue;
+        }
+        int y = (2 * i) / w, x = (2 * i) % w;
+        int g = (int)(31.5 + 31.5 * sin(x * 0.05 + pattern) * cos(y * 0.07));
+        if (pattern == 2 && ((x / 16 + y / 16) & 1))
+            g = 0;
+        uint32_t px = (uint32_t)(g << 5) | (rand() & 0x1f);
+        src[i] = px | (px << 16);
+    }
+}
+
+static bool check(int h, int w, int pattern)
+{
+    static normal_lut_t lut;
+    uint32_t *src = malloc(h * w * 2);
+    uint8_t *gray = malloc(h * w), *pad = malloc(h * w), *img = malloc(h * w);
+    float **p = alloc_rows(h, w), **q = alloc_rows(h, w), **p2 = alloc_rows(h, w), **q2 = alloc_rows(h, w);
+    float L[3], k, L2[3], k2;
+
+    srand(h * 31 + w * 7 + pattern);
+    make_frame(src, h, w, pattern);
+
+    // 3段
+    for (int i = 0; i < h * w / 2; i++)
+    {
+        gray[2 * i] = ref_green(src[i] & 0xffff);
+        gray[2 * i + 1] = ref_green(src[i] >> 16);
+    }
+    ref_pad(gray, pad, w, h, BORDER);
+    ref_estimate(h, w, pad, p, q, L, &k);
+
+    // 融合カーネル (ストリップ単位)
+    fused_front_t ff;
+    bool ok = fused_front_begin(&ff, h, w, BORDER, true);
+    for (int row = 0; ok && row < h;)
+    {
+        int rows = 1 + rand() % 37;
+        if (rows > h - row)
+            rows = h - row;
+        fused_front_rgb565(&ff, src + row * w / 2, rows, img);
+        row += rows;
+    }
+    if (ok)
+        fused_front_finish(&ff, img, p2, q2, L2, &k2, &lut);
+
+    ok = ok && memcmp(img, pad, h * w) == 0 && memcmp(L, L2, sizeof(L)) == 0 && memcmp(&k, &k2, sizeof(k)) == 0;
+    for (int y = 0; ok && y < h; y++)
+        ok = memcmp(p[y], p2[y], w * sizeof(float)) == 0 && memcmp(q[y], q2[y], w * sizeof(float)) == 0;
+    printf("%3dx%-3d pattern %d: %s\n", h, w, pattern, ok ? "bit-exact" : "DIFF");
+
+    free(src);
+    free(gray);
+    free(pad);
+    free(img);
+    free_rows(p, h);
+    free_rows(q, h);
+    free_rows(p2, h);
+    free_rows(q2, h);
+    return ok;
+}
+
+int main(void)
+{
+    bool ok = true;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+        for (int pattern = 0; pattern < 3; pattern++)
+            ok = check(sizes[s][0], sizes[s][1], pattern) && ok;
+    return ok ? 0 : 1;
+}
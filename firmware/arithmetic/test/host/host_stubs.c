@@ -0,0 +1,21 @@
+#include "pico.h"
+#include "image_process.h"
+
+unsigned int get_core_num(void)
+{
+    return 0;
+}
+
+// libimage_process.a (実機用のビルド済み) の estimate_normal() の書き写し. normal_lut_error() が使う
+void estimate_normal(int height, int width, unsigned char *img_gray, float **p, float **q, float *L)
+{
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            int I = img_gray[y * width + x];
+            p[y][x] = (float)((double)I / 255.0 * (double)L[0] / (double)L[2]);
+            q[y][x] = (float)((double)I / 255.0 * (double)L[1] / (double)L[2]);
+        }
+    }
+}
@@ -0,0 +1,12 @@
+#ifndef __HOST_PICO_H__
+#define __HOST_PICO_H__
+
+// ホストでのテスト用 (pico-sdk の代わり). 配置指定は無視する
+#define __not_in_flash(group)
+#define __not_in_flash_func(func) func
+#define __scratch_x(group)
+#define __scratch_y(group)
+
+unsigned int get_core_num(void);
+
+#endif //__HOST_PICO_H__
@@ -0,0 +1,6 @@
+#ifndef __HOST_SFE_PICO_H__
+#define __HOST_SFE_PICO_H__
+
+#include "sfe_pico_alloc.h"
+
+#endif //__HOST_SFE_PICO_H__
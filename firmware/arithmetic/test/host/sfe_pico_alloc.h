@@ -0,0 +1,19 @@
+#ifndef __HOST_SFE_PICO_ALLOC_H__
+#define __HOST_SFE_PICO_ALLOC_H__
+
+// ホストでのテスト用. SRAM / PSRAM の区別は無い
+#include <stdlib.h>
+
+static inline void *sfe_mem_malloc_fast(size_t size, size_t align)
+{
+    (void)align;
+    return malloc(size);
+}
+
+static inline void *sfe_mem_malloc_bulk(size_t size, size_t align)
+{
+    (void)align;
+    return malloc(size);
+}
+
+#endif //__HOST_SFE_PICO_ALLOC_H__
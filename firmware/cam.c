@@ -1,8 +1,10 @@
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 
 #include "hardware/pwm.h"
 #include "hardware/dma.h"
+#include "hardware/sync.h"
 #include "pico/multicore.h"
 
 #include "system.h"
@@ -12,6 +14,13 @@
 #include "udp.h"
 #include "image_process.h"
 #include "fft_helper.h"
+#include "fc_solver.h"
+#include "fc_fixed.h"
+#include "fused_front.h"
+#include "normal_lut.h"
+#include "depth_solver.h"
+#include "fft_mixed.h"
+#include "sfe_pico_alloc.h"
 
 #include "picampinos.pio.h"
 #include "ser_10base_t.pio.h"
@@ -22,12 +31,45 @@
 #if USE_100BASE_FX
 #include "sfp_hw.h"
 #endif
-#define USE_COLOR_IMAGE (0) // 0: Depth Estimate, 1:RGB565
 
-static semaphore_t fcmethod_semp;
 volatile bool irq_indicate_reset = true;
 
-volatile int32_t psram_access = 0; // write buffer:+=1, read buffer:-=1
+// frame ring
+#define CAM_SLOT_FREE (0)    // never written (or released and recycled)
+#define CAM_SLOT_WRITING (1) // armed for DMA
+#define CAM_SLOT_READY (2)   // complete frame
+
+typedef struct
+{
+    uint32_t *buf;
+    volatile uint16_t width; // frame geometry when the slot was published
+    volatile uint16_t height;
+    volatile uint32_t words;  // words written by DMA
+    volatile uint32_t length; // valid bytes (JPEG: 0 until the trailer is read by cam_acquire_frame())
+    volatile uint32_t seq;
+    volatile uint32_t timestamp_us;
+    volatile uint8_t state;
+    volatile uint8_t readers; // number of consumers holding this slot
+    volatile bool taken;      // acquired at least once (not counted as dropped)
+    volatile bool clear;      // zero the whole slot on the last release (pad capture)
+} cam_slot_t;
+
+static cam_slot_t cam_ring[CAM_RING_SLOTS];
+static spin_lock_t *cam_ring_lock;
+static volatile uint32_t frame_seq = 0;      // sequence number of the newest complete frame
+static volatile uint32_t frames_dropped = 0; // complete frames recycled before any consumer saw them
+
+// frame events (see 'cam_wait_frame()'). notification value: seq << 4 | slot
+#define CAM_FRAME_EVENT(seq, slot) (((seq) << 4) | (uint32_t)(slot))
+#define CAM_FRAME_EVENT_SLOT(ev) ((int32_t)((ev) & 0xF))
+#define CAM_FRAME_EVENT_SEQ(ev) ((ev) >> 4)
+#if CAM_RING_SLOTS > 16
+#error "CAM_RING_SLOTS does not fit in the frame event"
+#endif
+static TaskHandle_t cam_frame_waiter[CAM_FRAME_WAITERS];
+static volatile uint32_t cam_frame_waiters = 0;
+static uint32_t cam_frame_event;       // newest frame published by the IRQ (cam_ring_lock)
+static bool cam_frame_event_pending;   // not notified yet
 
 // init PIO
 static PIO pio_cam = pio0;
@@ -39,22 +81,145 @@ PIO pio_sfp = pio0; // same PIO with pio_iot
 // statemachine's pointer
 static uint32_t sm_cam; // CAMERA's state machines
 
+// capture mode
+static uint8_t cam_capture_mode = CAM_CAPTURE_RGB565;
+static uint32_t cam_frame_words = CAM_FUL_SIZE / 2; // words per frame
+static uint32_t cam_frame_w = IMG_W;                // pixels per line
+static uint32_t cam_frame_h = IMG_H;                // lines per frame
+static uint32_t cam_sensor_w = IMG_W;               // sensor output size (see 'cam_set_mode()')
+static uint32_t cam_sensor_h = IMG_H;
+static uint32_t cam_slot_words = 0;                 // capacity of a ring slot (in words)
+static uint8_t cam_device = DEV_OV5642;
+static uint8_t cam_frame_div = 1;
+static const pio_program_t *cam_program = NULL;     // program loaded on pio_cam
+static uint32_t offset_cam;
+static volatile bool cam_running = false;
+
+// ROI
+// PIO line command (see 'picampinos_roi' in 'picampinos.pio')
+#define CAM_ROI_CMD(vsync, lines, pre, count, gap) \
+    ((uint32_t)(vsync) | ((uint32_t)(lines) << 1) | ((uint32_t)(pre) << 9) | ((uint32_t)(count) << 19) | ((uint32_t)(gap) << 29))
+
+static bool cam_roi_enabled = false;
+static uint32_t cam_roi_first_line = 0;
+static uint32_t cam_roi_first_pixel = 0;
+static uint8_t cam_roi_skip = 1;
+static bool cam_line_cmd = false;             // PIO runs the ROI programs (ROI or pad capture)
+static uint32_t cam_roi_cmd[CAM_ROI_CMD_MAX]; // line commands of a frame (SRAM)
+static uint32_t cam_roi_cmd_len = 0;
+
+// pad capture
+// the inside of the border is written to each slot at its own stride, so a slot is already
+// the padded image of zeroPadImageWithBorder(). borders are zeroed once when the layout changes.
+// DMA_CAM_RD_CH0 moves a line, DMA_CAM_RD_CH1 loads the write address of the next line.
+static bool cam_pad_enabled = false;
+static uint32_t cam_pad_list[CAM_RING_SLOTS][CAM_MODE_MAX_H + 1]; // line addresses of each slot (NULL terminated)
+static uint32_t cam_pad_sink_list[CAM_MODE_MAX_H + 1];            // ... of a frame with no free slot (all lines to the sink)
+
 // dma channels
 static uint32_t DMA_CAM_RD_CH0;
 static uint32_t DMA_CAM_RD_CH1;
+static uint32_t DMA_CAM_CMD_CH; // ROI line commands -> TX FIFO
+static int32_t dma_slot[2]; // ring slot armed on DMA_CAM_RD_CH0 / DMA_CAM_RD_CH1 (-1: the sink)
+static volatile uint32_t cam_dma_sink; // DMA target of a frame with no free slot (slot -1, not incremented)
+
+// row strips
+// DMA_CAM_RD_CH0/CH1 write strips of a frame alternately, and every strip is queued to consumers.
+static uint32_t cam_strip_rows = 0;          // requested rows per strip (0: frame mode)
+static uint32_t cam_strips = 1;              // strips per frame (1: frame mode)
+static uint32_t dma_strip[2];                // strip index armed on DMA_CAM_RD_CH0 / DMA_CAM_RD_CH1
+static int32_t arm_slot;                     // slot of the next strip to arm
+static uint32_t arm_strip;                   // index of the next strip to arm
+static QueueHandle_t cam_strip_queue;        // cam_strip_t
+static volatile uint32_t strips_dropped = 0; // strips not queued (queue full)
 
 // private functions and buffers
-static uint32_t *cam_ptr;  // pointer of camera buffer
-static uint32_t *cam_ptr1; // 2nd pointer of cam_ptr.
-static uint8_t *gray_ptr;  // pointer of gray image.
+static uint8_t *gray_ptr;  // pointer of gray image. PAD_W x PAD_H: the largest mode of depth estimation
+#if !(USE_COLOR_IMAGE) && (IMG_W > PAD_W || IMG_H > PAD_H)
+#error "the mode after init_cam() (IMG_W x IMG_H) must fit in the depth estimation buffers (PAD_W x PAD_H)"
+#endif
 static uint8_t *pad_ptr;   // 1st pointer of padded image.
-static float_t **p1_ptr;   // gradient map
-static float_t **q1_ptr;   // gradient map
-static float_t **d1_ptr;   // depth map.
+// depth values per UDP packet (after the 4 word block header). wider rows are split
+#define CAM_DEPTH_PKT_FLOATS ((DEF_UDP_PAYLOAD_SIZE - 4 * sizeof(uint32_t)) / sizeof(float_t))
+// UDP payload / 10BASE-T frame of rj45_cam(). in SRAM: the serializer DMA must not wait for PSRAM
+static uint8_t *udp_payload1;
+static uint32_t *tx_buf_udp1;
+
+// depth pipeline (see 'cam.h')
+typedef struct
+{
+    float_t **p; // gradient map (USE_FC_PACKED: a bank of the work area of fcmethod_packed())
+    float_t **q;
+    uint32_t width; // size of the frame
+    uint32_t height;
+    uint32_t seq;
+    float L[3]; // light source and k of the frame
+    float k;
+} cam_grad_t;
+
+typedef struct
+{
+#if USE_REAL_FFT && USE_FC_FIXED
+    q15_t **d; // depth = d * 2^exp
+    int32_t exp;
+#elif USE_REAL_FFT && USE_FC_PACKED && USE_FC_HALF
+    half_t **d;
+#else
+    float_t **d;
+#endif
+    uint32_t width; // size of the depth map
+    uint32_t height;
+    uint32_t seq;
+    float L[3]; // light source and k used for the depth map (sent in the frame header)
+    float k;
+} cam_depth_t;
+
+#if USE_REAL_FFT && USE_FC_FIXED
+#define CAM_GRAD_BUFS (1) // p, q are the Q31 work area of fcmethod_fixed() (one only)
+#else
+#define CAM_GRAD_BUFS (CAM_PIPE_GRAD_BUFS)
+#endif
 
-dma_channel_config get_cam_config(PIO pio, uint32_t sm, uint32_t dma_chan);
+static cam_grad_t cam_grad[CAM_GRAD_BUFS];
+static QueueHandle_t cam_grad_free; // cam_grad_t *: A <- B
+static QueueHandle_t cam_grad_full; // cam_grad_t *: A -> B
+
+// depth maps between B and C (triple buffer). only the pointers are swapped under cam_depth_lock
+#define CAM_DEPTH_BUFS (3)
+static cam_depth_t cam_depth[CAM_DEPTH_BUFS];
+static cam_depth_t *cam_depth_write;  // B is writing
+static cam_depth_t *cam_depth_latest; // last completed
+static cam_depth_t *cam_depth_send;   // C is sending (or has sent)
+static volatile bool cam_depth_fresh; // cam_depth_latest has not been taken by C
+static spin_lock_t *cam_depth_lock;
+static volatile cam_stage_stats_t cam_stage[CAM_STAGES];
+static volatile uint32_t cam_stage_t0; // time of the last cam_reset_pipe_stats()
+static fft_helper_stats_t cam_helper_t0; // fft_helper_get_stats() at cam_reset_pipe_stats()
+
+// depth solvers other than FC need the float depth map of fcmethod_packed()
+#define CAM_DEPTH_SOLVERS (USE_REAL_FFT && USE_FC_PACKED && !USE_FC_HALF && !USE_FC_FIXED)
+static volatile int cam_depth_solver = DEPTH_SOLVER_FC; // DEPTH_SOLVER_*
+
+// FFT sizes of the depth pipeline: powers of 2 (rdft2d()), or 2^a 3^b 5^c (even) for fcmethod_packed()
+// with the mixed-radix FFT (arithmetic/fft_mixed.h), e.g. 640x480, 480x480, 320x240
+static bool cam_fft_size_ok(uint32_t width, uint32_t height)
+{
+    if ((width & (width - 1)) == 0 && (height & (height - 1)) == 0)
+        return true;
+#if CAM_DEPTH_SOLVERS
+    return (width % 2) == 0 && (height % 2) == 0 && fft_mixed_size_ok(width) && fft_mixed_size_ok(height);
+#else
+    return false;
+#endif
+}
+
+dma_channel_config get_cam_config(PIO pio, uint32_t sm, uint32_t dma_chan, enum dma_channel_transfer_size size);
 void set_pwm_freq_kHz(uint32_t freq_khz, uint32_t system_clk_khz, uint8_t gpio_num);
 void cam_handler();
+void cam_jpeg_handler();
+static int32_t cam_ring_arm_next(void);
+static void cam_dma_arm(uint32_t dma_chan, int32_t slot, uint32_t offset);
+static uint32_t *cam_pad_line_list(int32_t slot);
 
 static void memory_stats()
 {
@@ -65,145 +230,1294 @@ static void memory_stats()
 
     size_t max_block = sfe_mem_max_free_size();
     printf("\tMax free block size: 0x%X (%u) \n", max_block, max_block);
+
+    sfe_mem_stats_t st;
+    sfe_mem_get_stats(&st);
+    for (int32_t i = 0; i < SFE_MEM_POOLS; i++)
+    {
+        sfe_mem_pool_stats_t *p = &st.pool[i];
+        printf("\t%s - blocks: %u  fallbacks: %u  in use: %u  peak: %u\n", (i == SFE_MEM_POOL_SRAM) ? "SRAM " : "PSRAM",
+               p->allocs, p->fallbacks, p->in_use, p->peak);
+    }
+    if (st.failures)
+        printf("\tallocation failures: %u\n", st.failures);
+}
+
+// (re)load the capture program for cam_capture_mode and the ROI setting.
+// the state machine must be stopped.
+static void cam_load_program(void)
+{
+    pio_sm_set_enabled(pio_cam, sm_cam, false);
+    if (cam_program != NULL)
+    {
+        pio_remove_program(pio_cam, cam_program, offset_cam);
+    }
+
+    switch (cam_capture_mode)
+    {
+    case CAM_CAPTURE_GREEN:
+        if (cam_line_cmd)
+        {
+            cam_program = &picampinos_green_roi_program;
+            offset_cam = pio_add_program(pio_cam, cam_program);
+            picampinos_green_roi_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11);
+        }
+        else
+        {
+            cam_program = &picampinos_green_program;
+            offset_cam = pio_add_program(pio_cam, cam_program);
+            picampinos_green_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11); // VSYNC,HREF,PCLK,D[2:9] : total 11 pins
+        }
+        // 4 pixels per word
+        cam_frame_words = cam_frame_w * cam_frame_h / 4;
+        break;
+    case CAM_CAPTURE_Y8:
+        if (cam_line_cmd)
+        {
+            cam_program = &picampinos_luma_roi_program;
+            offset_cam = pio_add_program(pio_cam, cam_program);
+            picampinos_luma_roi_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11);
+        }
+        else
+        {
+            cam_program = &picampinos_luma_program;
+            offset_cam = pio_add_program(pio_cam, cam_program);
+            picampinos_luma_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11);
+        }
+        cam_frame_words = cam_frame_w * cam_frame_h / 4;
+        break;
+    case CAM_CAPTURE_JPEG:
+        cam_program = &picampinos_jpeg_program;
+        offset_cam = pio_add_program(pio_cam, cam_program);
+        picampinos_jpeg_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11);
+        // slot capacity (same as RGB565). data + partial word + byte count must fit in.
+        cam_frame_words = cam_frame_w * cam_frame_h / 2;
+        break;
+    default:
+        if (cam_line_cmd)
+        {
+            cam_program = &picampinos_roi_program;
+            offset_cam = pio_add_program(pio_cam, cam_program);
+            picampinos_roi_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11);
+        }
+        else
+        {
+            cam_program = &picampinos_program;
+            offset_cam = pio_add_program(pio_cam, cam_program);
+            picampinos_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11);
+        }
+        // RGB565: 2 pixels per word
+        cam_frame_words = cam_frame_w * cam_frame_h / 2;
+        break;
+    }
+    pio_sm_set_enabled(pio_cam, sm_cam, false);
+    pio_sm_clear_fifos(pio_cam, sm_cam);
+    pio_sm_restart(pio_cam, sm_cam);
+    pio_sm_set_enabled(pio_cam, sm_cam, true);
+}
+
+// wait until the sensor outputs 'frames' VSYNC pulses (stream is running and AE/AWB has a few frames to settle).
+// VSYNC is read as GPIO before PIO takes the pins.
+static bool cam_wait_frames(uint32_t frames, uint32_t timeout_ms)
+{
+    const uint32_t vsync_pin = CAM_BASE_PIN + 8;
+    absolute_time_t timeout = make_timeout_time_ms(timeout_ms);
+
+    gpio_init(vsync_pin);
+    gpio_set_dir(vsync_pin, GPIO_IN);
+    bool last = gpio_get(vsync_pin);
+    while (frames > 0)
+    {
+        bool vsync = gpio_get(vsync_pin);
+        if (vsync && !last)
+            frames--;
+        last = vsync;
+        if (absolute_time_diff_us(get_absolute_time(), timeout) <= 0)
+        {
+            printf("camera stream not detected\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+// (re)allocate all slots of the ring with 'words' each. no DMA and no consumer may use the ring.
+// returns false and keeps the old capacity if PSRAM is short.
+static bool cam_ring_alloc(uint32_t words)
+{
+    bool ok = true;
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        free(cam_ring[i].buf);
+        cam_ring[i].buf = NULL;
+    }
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        cam_ring[i].buf = (uint32_t *)sfe_mem_malloc_bulk(words * sizeof(uint32_t), 0);
+        ok = ok && (cam_ring[i].buf != NULL);
+    }
+    if (ok)
+    {
+        cam_slot_words = words;
+        return true;
+    }
+
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        free(cam_ring[i].buf);
+        cam_ring[i].buf = NULL;
+    }
+    for (int32_t i = 0; i < CAM_RING_SLOTS && cam_slot_words > 0; i++)
+    {
+        cam_ring[i].buf = (uint32_t *)sfe_mem_malloc_bulk(cam_slot_words * sizeof(uint32_t), 0);
+    }
+    return false;
+}
+
+void init_cam(uint8_t DEVICE_IS, uint8_t capture_mode)
+{
+    sfe_pico_alloc_init();
+
+    // Initialize CAMERA
+    set_pwm_freq_kHz(20000, SYS_CLK_IN_KHZ, PIN_PWM0); // XCLK 24MHz -> OV5642,OV2640
+
+    // polls the chip ID until the sensor wakes up, then writes the register profile
+    sccb_init(DEVICE_IS, I2C1_SDA, I2C1_SCL, true); // sda,scl=(gp26,gp27). see 'sccb_if.c' and 'cam.h'
+    cam_device = DEVICE_IS;
+    if (capture_mode == CAM_CAPTURE_Y8)
+    {
+        sccb_set_output_format(DEVICE_IS, SCCB_FMT_YUV422);
+    }
+    if (capture_mode == CAM_CAPTURE_JPEG)
+    {
+        if (DEVICE_IS == DEV_OV5642)
+            sccb_set_output_format(DEVICE_IS, SCCB_FMT_JPEG);
+        else
+            capture_mode = CAM_CAPTURE_RGB565;
+    }
+    cam_wait_frames(CAM_STARTUP_FRAMES, CAM_STARTUP_TIMEOUT_MS);
+
+    cam_capture_mode = capture_mode;
+    if (cam_capture_mode != CAM_CAPTURE_GREEN && cam_capture_mode != CAM_CAPTURE_Y8 &&
+        cam_capture_mode != CAM_CAPTURE_JPEG)
+        cam_capture_mode = CAM_CAPTURE_RGB565;
+    cam_load_program();
+
+    // init DMA
+    DMA_CAM_RD_CH0 = dma_claim_unused_channel(true);
+    DMA_CAM_RD_CH1 = dma_claim_unused_channel(true);
+    DMA_CAM_CMD_CH = dma_claim_unused_channel(true);
+
+    // IRQ settings
+    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH0, false);
+    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH1, false);
+
+    // printf("DMA_CH= %d,%d\n", DMA_CAM_RD_CH0, DMA_CAM_RD_CH1);
+
+    // buffer of camera data is IMG_W * IMG_H * 2 bytes (RGB565 = 16 bits = 2 bytes)
+    // or IMG_W * IMG_H bytes (CAM_CAPTURE_GREEN, CAM_CAPTURE_Y8)
+    // camera buffer on PSRAM
+    // | slot0 | slot1 | ... | slot(N-1) | frame ring (CAM_RING_SLOTS)
+    // |----------|-----------|
+    // | -- gray -- |           gray image
+    // |----------|-----------|
+    // | - pad1 - | - pad2 -- | padded image 1 and 2
+    // |----------|-----------|
+    // | -------- p[n]  ----- | real and imag of x-normal   (CAM_PIPE_GRAD_BUFS)
+    // | -------- q[n]  ----- | real and imag of y-normal
+    // | -------- d[3]  ----- | depth estimation            (write, latest, send)
+    // |----------|-----------|
+
+    init_image_process(PAD_H, PAD_W);
+    // frame ring
+    bool ring_ok = true;
+    cam_ring_lock = spin_lock_init(spin_lock_claim_unused(true));
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        cam_ring[i].buf = NULL;
+        cam_ring[i].width = 0;
+        cam_ring[i].height = 0;
+        cam_ring[i].words = 0;
+        cam_ring[i].length = 0;
+        cam_ring[i].seq = 0;
+        cam_ring[i].timestamp_us = 0;
+        cam_ring[i].state = CAM_SLOT_FREE;
+        cam_ring[i].readers = 0;
+        cam_ring[i].taken = false;
+        cam_ring[i].clear = false;
+    }
+    ring_ok = cam_ring_alloc(cam_frame_words); // full frame (ROI is always smaller)
+    // frames and maps are read in rows: PSRAM. the padded image is read in 3x3 windows by the
+    // normal estimation: SRAM while it fits
+    // gray image: the largest frame cam_set_mode() accepts for depth estimation, not the mode after init
+    gray_ptr = (uint8_t *)sfe_mem_malloc_bulk((PAD_H * PAD_W) * sizeof(uint8_t), 0);
+    // 262144
+    //  padded image 1 and 2
+    //  normal map1 and depth map1
+    pad_ptr = (uint8_t *)sfe_mem_malloc_fast((PAD_H * PAD_W) * sizeof(uint8_t), 0);
+    udp_payload1 = (uint8_t *)sfe_mem_malloc_fast(DEF_UDP_PAYLOAD_SIZE, 4);
+    tx_buf_udp1 = (uint32_t *)sfe_mem_malloc_fast((DEF_UDP_BUF_SIZE + 1) * sizeof(uint32_t), 0);
+    if (udp_payload1 && tx_buf_udp1)
+    {
+        memset(udp_payload1, 0, DEF_UDP_PAYLOAD_SIZE);
+        memset(tx_buf_udp1, 0, (DEF_UDP_BUF_SIZE + 1) * sizeof(uint32_t));
+    }
+#if CAM_DEPTH_SOLVERS && DEPTH_SOLVER_BENCH
+    // before the FC banks: the bench reallocates the FC work area at each size
+    depth_solver_bench();
+#endif
+    // p, q of each gradient buffer and the depth maps of the pipeline
+    bool pipe_ok;
+#if USE_REAL_FFT && USE_FC_FIXED
+    // p, q are the two halves of the Q31 work area of fcmethod_fixed(). depth map is Q15
+    if (init_fc_fixed(PAD_H, PAD_W))
+    {
+        cam_grad[0].p = fc_fixed_view(0);
+        cam_grad[0].q = fc_fixed_view(1);
+    }
+    for (int32_t i = 0; i < CAM_DEPTH_BUFS; i++)
+    {
+        cam_depth[i].d = alloc_2d_q15(PAD_H, PAD_W);
+        cam_depth[i].exp = 0;
+    }
+#elif USE_REAL_FFT && USE_FC_PACKED
+    // p, q are the two halves of a bank of the complex work area of fcmethod_packed() (packed without copy).
+    // one bank per gradient buffer: A writes normals into one while B transforms the other
+    if (init_fc_packed_banks(PAD_H, PAD_W, CAM_GRAD_BUFS))
+    {
+        for (int32_t i = 0; i < CAM_GRAD_BUFS; i++)
+        {
+            cam_grad[i].p = fc_packed_bank_view(i, 0);
+            cam_grad[i].q = fc_packed_bank_view(i, 1);
+        }
+    }
+    for (int32_t i = 0; i < CAM_DEPTH_BUFS; i++)
+    {
+#if USE_FC_HALF
+        cam_depth[i].d = alloc_2d_half(PAD_H, PAD_W);
+#else
+        cam_depth[i].d = alloc_2d_float(PAD_H, PAD_W);
+#endif
+    }
+#else
+    // complex FFT (!USE_REAL_FFT) needs real and imaginary parts
+    const int32_t cols = USE_REAL_FFT ? PAD_W : PAD_W * 2;
+    for (int32_t i = 0; i < CAM_GRAD_BUFS; i++)
+    {
+        cam_grad[i].p = alloc_2d_float(PAD_H, cols);
+        cam_grad[i].q = alloc_2d_float(PAD_H, cols);
+    }
+    for (int32_t i = 0; i < CAM_DEPTH_BUFS; i++)
+    {
+        cam_depth[i].d = alloc_2d_float(PAD_H, cols);
+    }
+#endif
+    cam_grad_free = xQueueCreate(CAM_GRAD_BUFS, sizeof(cam_grad_t *));
+    cam_grad_full = xQueueCreate(CAM_GRAD_BUFS, sizeof(cam_grad_t *));
+    pipe_ok = cam_grad_free && cam_grad_full;
+    for (int32_t i = 0; i < CAM_GRAD_BUFS; i++)
+    {
+        cam_grad_t *g = &cam_grad[i];
+        pipe_ok = pipe_ok && g->p && g->q;
+        if (pipe_ok)
+            xQueueSend(cam_grad_free, &g, 0);
+    }
+    for (int32_t i = 0; i < CAM_DEPTH_BUFS; i++)
+    {
+        pipe_ok = pipe_ok && cam_depth[i].d;
+        cam_depth[i].width = 0;
+        cam_depth[i].height = 0;
+        cam_depth[i].seq = 0;
+    }
+    cam_depth_write = &cam_depth[0];
+    cam_depth_latest = &cam_depth[1];
+    cam_depth_send = &cam_depth[2];
+    cam_depth_fresh = false;
+    cam_depth_lock = spin_lock_init(spin_lock_claim_unused(true));
+    cam_reset_pipe_stats();
+    if (!ring_ok || !gray_ptr || !pad_ptr || !udp_payload1 || !tx_buf_udp1 || !pipe_ok)
+    {
+        printf("Big block built in allocation failed\n");
+        // return 1;
+    }
+
+    if (!cam_set_depth_solver(DEPTH_SOLVER_DEFAULT))
+        printf("depth solver %d is not available\n", DEPTH_SOLVER_DEFAULT);
+
+    // todo: check psram size
+    memory_stats();
+    cam_strip_queue = xQueueCreate(CAM_STRIP_QUEUE_LEN, sizeof(cam_strip_t));
+}
+
+void config_cam_buffer()
+{
+    // ------------------ CAMERA READ: withDMA   --------------------------------
+
+    // disable IRQ
+    irq_set_enabled(DMA_IRQ_0, false);
+
+    // pick slots for CH0 and CH1. the others are free for consumers.
+    // (slots left armed by the previous run(see 'cam_set_roi()') are recycled)
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        if (cam_ring[i].state == CAM_SLOT_WRITING)
+            cam_ring[i].state = CAM_SLOT_FREE;
+    }
+    cam_strips = 1;
+    if (!cam_pad_enabled && cam_strip_rows > 0 && (cam_frame_h % cam_strip_rows) == 0 && (cam_frame_h / cam_strip_rows) >= 2)
+        cam_strips = cam_frame_h / cam_strip_rows;
+    if (cam_pad_enabled || cam_capture_mode == CAM_CAPTURE_JPEG)
+    {
+        // 1 slot on CH0 (pad: CH1 is the control channel, JPEG: CH1 is not used)
+        dma_slot[0] = cam_ring_arm_next();
+        dma_slot[1] = -1;
+        dma_strip[0] = 0;
+    }
+    else if (cam_strips > 1)
+    {
+        // strip0 -> CH0, strip1 -> CH1 of the same slot
+        arm_slot = cam_ring_arm_next();
+        for (int32_t ch = 0; ch < 2; ch++)
+        {
+            dma_slot[ch] = arm_slot;
+            dma_strip[ch] = ch;
+        }
+        arm_strip = 2 % cam_strips;
+    }
+    else
+    {
+        for (int32_t ch = 0; ch < 2; ch++)
+        {
+            dma_slot[ch] = cam_ring_arm_next();
+            dma_strip[ch] = 0;
+        }
+    }
+    spin_unlock(cam_ring_lock, save);
+    // slots held by consumers are not armed: with no free slot the first frames go to the sink (see 'cam_dma_arm()')
+
+    // full frame : 1 word per transfer
+    // ROI, pad   : 1 pixel per transfer, from the upper half(RGB565) or byte(8bit) of RX FIFO
+    const volatile void *src = &pio_cam->rxf[sm_cam];
+    enum dma_channel_transfer_size size = DMA_SIZE_32;
+    uint32_t count = cam_frame_words;
+    uint32_t strip_words = cam_frame_words / cam_strips;
+    if (cam_line_cmd)
+    {
+        count = cam_frame_w * cam_frame_h;
+        if (cam_capture_mode == CAM_CAPTURE_RGB565)
+        {
+            src = (const volatile uint8_t *)&pio_cam->rxf[sm_cam] + 2;
+            size = DMA_SIZE_16;
+        }
+        else
+        {
+            src = (const volatile uint8_t *)&pio_cam->rxf[sm_cam] + 3;
+            size = DMA_SIZE_8;
+        }
+    }
+    count /= cam_strips;
+
+    dma_channel_config c;
+    if (cam_capture_mode == CAM_CAPTURE_JPEG)
+    {
+        // (1) JPEG : the whole slot on CH0. the end of frame is told by PIO IRQ(see 'cam_jpeg_handler()'),
+        // DMA IRQ means the frame did not fit in the slot.
+        c = get_cam_config(pio_cam, sm_cam, DMA_CAM_RD_CH0, DMA_SIZE_32);
+        dma_channel_configure(DMA_CAM_RD_CH0, &c,
+                              NULL,            // Destination pointer(set by cam_dma_arm())
+                              src,             // Source pointer
+                              cam_frame_words, // Number of transfers(capacity of a slot)
+                              false            // Don't Start yet
+        );
+        cam_dma_arm(DMA_CAM_RD_CH0, dma_slot[0], 0);
+
+        pio_interrupt_clear(pio_cam, 0);
+        pio_set_irq0_source_enabled(pio_cam, pis_interrupt0, true);
+        irq_set_exclusive_handler(pio_get_irq_num(pio_cam, 0), cam_jpeg_handler);
+        irq_set_enabled(pio_get_irq_num(pio_cam, 0), true);
+    }
+    else if (cam_pad_enabled)
+    {
+        // (2) control channel : next line address -> CH0's WRITE_ADDR_TRIG
+        c = dma_channel_get_default_config(DMA_CAM_RD_CH1);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        dma_channel_configure(DMA_CAM_RD_CH1, &c,
+                              &dma_hw->ch[DMA_CAM_RD_CH0].al2_write_addr_trig, // Destination pointer
+                              cam_pad_line_list(dma_slot[0]),                  // Source pointer
+                              1,                                               // 1 address per line
+                              false                                            // Don't Start yet
+        );
+
+        // (1) data channel : 1 line, then chain to the control channel.
+        // IRQ only on the NULL address at the end of the list(= end of frame)
+        c = get_cam_config(pio_cam, sm_cam, DMA_CAM_RD_CH0, size);
+        channel_config_set_chain_to(&c, DMA_CAM_RD_CH1);
+        channel_config_set_irq_quiet(&c, true);
+        dma_channel_configure(DMA_CAM_RD_CH0, &c,
+                              NULL,                             // Destination pointer(set by the control channel)
+                              src,                              // Source pointer
+                              cam_frame_w - 2 * CAM_PAD_BORDER, // Number of transfers(a line)
+                              false                             // Don't Start yet
+        );
+        cam_dma_arm(DMA_CAM_RD_CH0, dma_slot[0], 0); // write increment only (addresses come from the line list)
+    }
+    else
+    {
+        // (2) 1st DMA Channel Config
+        c = get_cam_config(pio_cam, sm_cam, DMA_CAM_RD_CH1, size);
+        // trigger DMA_CAM_RD_CH0 when DMA_CAM_RD_CH1 completes. (ping-pong)
+        channel_config_set_chain_to(&c, DMA_CAM_RD_CH0);
+        dma_channel_configure(DMA_CAM_RD_CH1, &c,
+                              NULL,  // Destination pointer(set by cam_dma_arm())
+                              src,   // Source pointer
+                              count, // Number of transfers
+                              false  // Don't Start yet
+        );
+        cam_dma_arm(DMA_CAM_RD_CH1, dma_slot[1], dma_strip[1] * strip_words);
+
+        // (1) 0th DMA Channel Config
+        c = get_cam_config(pio_cam, sm_cam, DMA_CAM_RD_CH0, size);
+        // trigger DMA_CAM_RD_CH1 when DMA_CAM_RD_CH0 completes.
+        channel_config_set_chain_to(&c, DMA_CAM_RD_CH1);
+        dma_channel_configure(DMA_CAM_RD_CH0, &c,
+                              NULL,  // Destination pointer(set by cam_dma_arm())
+                              src,   // Source pointer
+                              count, // Number of transfers
+                              false  // Don't Start yet
+        );
+        cam_dma_arm(DMA_CAM_RD_CH0, dma_slot[0], dma_strip[0] * strip_words);
+    }
+
+    // (3) ROI line commands -> TX FIFO (restarted by cam_handler() every frame)
+    if (cam_line_cmd)
+    {
+        c = dma_channel_get_default_config(DMA_CAM_CMD_CH);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_dreq(&c, pio_get_dreq(pio_cam, sm_cam, true));
+        dma_channel_configure(DMA_CAM_CMD_CH, &c,
+                              &pio_cam->txf[sm_cam], // Destination pointer
+                              cam_roi_cmd,           // Source pointer
+                              cam_roi_cmd_len,       // Number of transfers
+                              false                  // Don't Start yet
+        );
+    }
+
+    // IRQ settings
+    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH1, !cam_pad_enabled && cam_capture_mode != CAM_CAPTURE_JPEG);
+    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH0, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, cam_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// frame ring
+// hand slot 'i' to a consumer. must be called with cam_ring_lock held.
+static void cam_ring_take(int32_t i, cam_frame_t *frm)
+{
+    cam_slot_t *sl = &cam_ring[i];
+    if (cam_capture_mode == CAM_CAPTURE_JPEG && sl->length == 0 && sl->words >= 2)
+    {
+        // | data ... | partial word(MSB aligned) | byte count |
+        uint32_t len = sl->buf[sl->words - 1];
+        if (len / 4 + 2 == sl->words)
+        {
+            if (len % 4)
+                sl->buf[len / 4] >>= 8 * (4 - len % 4);
+            sl->length = len;
+        }
+        else
+        {
+            sl->words = 0; // broken frame (length stays 0)
+        }
+    }
+    sl->readers++;
+    sl->taken = true;
+    frm->buf = sl->buf;
+    frm->width = sl->width;
+    frm->height = sl->height;
+    frm->length = sl->length;
+    frm->seq = sl->seq;
+    frm->timestamp_us = sl->timestamp_us;
+    frm->slot = i;
+}
+
+bool cam_acquire_frame(cam_frame_t *frm, uint32_t last_seq)
+{
+    int32_t newest = -1;
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        if (cam_ring[i].state == CAM_SLOT_READY && cam_ring[i].seq > last_seq &&
+            (newest < 0 || cam_ring[i].seq > cam_ring[newest].seq))
+        {
+            newest = i;
+        }
+    }
+    if (newest >= 0)
+        cam_ring_take(newest, frm);
+    spin_unlock(cam_ring_lock, save);
+    return (newest >= 0);
+}
+
+// the slot named by a frame event, if it still holds that frame
+static bool cam_acquire_event(cam_frame_t *frm, uint32_t ev, uint32_t last_seq)
+{
+    int32_t i = CAM_FRAME_EVENT_SLOT(ev);
+    bool ok = false;
+    if (i >= CAM_RING_SLOTS)
+        return false;
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    if (cam_ring[i].state == CAM_SLOT_READY && cam_ring[i].seq > last_seq &&
+        CAM_FRAME_EVENT(cam_ring[i].seq, i) == ev)
+    {
+        cam_ring_take(i, frm);
+        ok = true;
+    }
+    spin_unlock(cam_ring_lock, save);
+    return ok;
+}
+
+// add the calling task to the tasks notified by the IRQ (once per task)
+static bool cam_frame_register(void)
+{
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    bool ok = false;
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    for (uint32_t i = 0; i < cam_frame_waiters; i++)
+        ok = ok || (cam_frame_waiter[i] == self);
+    if (!ok && cam_frame_waiters < CAM_FRAME_WAITERS)
+    {
+        cam_frame_waiter[cam_frame_waiters] = self;
+        cam_frame_waiters++; // the IRQ reads the count after the entry is written
+        ok = true;
+    }
+    spin_unlock(cam_ring_lock, save);
+    return ok;
+}
+
+bool cam_wait_frame(cam_frame_t *frm, uint32_t last_seq, TickType_t timeout)
+{
+    TimeOut_t to;
+    uint32_t ev;
+
+    if (!cam_frame_register())
+        return cam_acquire_frame(frm, last_seq);
+
+    // clear an old event before looking at the ring: a frame published after the check is still notified
+    xTaskNotifyStateClearIndexed(NULL, CAM_FRAME_NOTIFY_INDEX);
+    if (cam_acquire_frame(frm, last_seq))
+        return true;
+
+    vTaskSetTimeOutState(&to);
+    while (xTaskNotifyWaitIndexed(CAM_FRAME_NOTIFY_INDEX, 0, 0, &ev, timeout) == pdTRUE)
+    {
+        // the slot of the event, or the newest one if it has been recycled meanwhile
+        if (cam_acquire_event(frm, ev, last_seq) || cam_acquire_frame(frm, last_seq))
+            return true;
+        if (xTaskCheckForTimeOut(&to, &timeout) == pdTRUE)
+            break;
+    }
+    return false;
+}
+
+// notify the waiting tasks of the frame published in this IRQ (after cam_ring_lock is released)
+static void cam_frame_notify(BaseType_t *woken)
+{
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    bool pending = cam_frame_event_pending;
+    uint32_t ev = cam_frame_event;
+    cam_frame_event_pending = false;
+    spin_unlock(cam_ring_lock, save);
+    if (!pending)
+        return;
+    for (uint32_t i = 0; i < cam_frame_waiters; i++)
+    {
+        xTaskNotifyIndexedFromISR(cam_frame_waiter[i], CAM_FRAME_NOTIFY_INDEX, ev, eSetValueWithOverwrite, woken);
+    }
+}
+
+// drop a reader of slot 'i' (frame or strip)
+static void cam_ring_release(int32_t i)
+{
+    cam_slot_t *slot = &cam_ring[i];
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    if (slot->clear && slot->readers == 1)
+    {
+        // last reader of a slot left from the previous layout: zero it before DMA can use it.
+        // (the slot is FREE, so no one can acquire it again)
+        spin_unlock(cam_ring_lock, save);
+        memset(slot->buf, 0, cam_frame_words * sizeof(uint32_t));
+        save = spin_lock_blocking(cam_ring_lock);
+        slot->clear = false;
+    }
+    if (slot->readers > 0)
+        slot->readers--;
+    spin_unlock(cam_ring_lock, save);
+}
+
+void cam_release_frame(cam_frame_t *frm)
+{
+    if (frm->slot < 0)
+        return;
+    cam_ring_release(frm->slot);
+    frm->slot = -1;
+}
+
+void cam_get_frame_stats(uint32_t *captured, uint32_t *dropped)
+{
+    *captured = frame_seq;
+    *dropped = frames_dropped;
+}
+
+// ROI
+// one command per captured line. the 1st command waits VSYNC and skips 'first_line' lines,
+// the others skip (skip - 1) lines. each command consumes (lines to skip + 1) lines.
+static void cam_roi_build_cmd(uint32_t first_line, uint32_t first_pixel, uint8_t skip, uint32_t width, uint32_t height)
+{
+    uint32_t n = 0;
+    uint32_t vsync = 1;
+    uint32_t lines = first_line;
+
+    // too long for 8bit : skip with empty lines
+    while (lines > CAM_ROI_MAX_SKIP_LINES)
+    {
+        cam_roi_cmd[n++] = CAM_ROI_CMD(vsync, CAM_ROI_MAX_SKIP_LINES, 0, 0, 0);
+        lines -= CAM_ROI_MAX_SKIP_LINES + 1;
+        vsync = 0;
+    }
+    for (uint32_t h = 0; h < height; h++)
+    {
+        cam_roi_cmd[n++] = CAM_ROI_CMD(vsync, lines, first_pixel, width, skip - 1);
+        vsync = 0;
+        lines = skip - 1;
+    }
+    cam_roi_cmd_len = n;
+}
+
+// select the capture program and build line commands (and line lists) for the ROI and pad settings
+static void cam_update_line_cmd(void)
+{
+    cam_line_cmd = cam_roi_enabled || cam_pad_enabled;
+    if (cam_pad_enabled)
+    {
+        // capture the inside of the border only
+        uint32_t b = CAM_PAD_BORDER;
+        cam_roi_build_cmd(cam_roi_first_line + b * cam_roi_skip, cam_roi_first_pixel + b * cam_roi_skip,
+                          cam_roi_skip, cam_frame_w - 2 * b, cam_frame_h - 2 * b);
+        for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+        {
+            uint8_t *p = (uint8_t *)cam_ring[i].buf;
+            uint32_t n = 0;
+            for (uint32_t y = b; y < cam_frame_h - b; y++)
+            {
+                cam_pad_list[i][n++] = (uint32_t)(p + y * cam_frame_w + b);
+            }
+            cam_pad_list[i][n] = 0; // NULL trigger : end of frame
+        }
+        for (uint32_t n = 0; n < cam_frame_h - 2 * b; n++)
+        {
+            cam_pad_sink_list[n] = (uint32_t)&cam_dma_sink;
+        }
+        cam_pad_sink_list[cam_frame_h - 2 * b] = 0;
+    }
+    else if (cam_roi_enabled)
+    {
+        cam_roi_build_cmd(cam_roi_first_line, cam_roi_first_pixel, cam_roi_skip, cam_frame_w, cam_frame_h);
+    }
+}
+
+// zero all slots for a new pad layout. slots held by consumers are zeroed on their last release.
+static void cam_ring_clear(void)
+{
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        uint32_t save = spin_lock_blocking(cam_ring_lock);
+        bool held = (cam_ring[i].readers > 0);
+        cam_ring[i].state = CAM_SLOT_FREE;
+        cam_ring[i].seq = 0;
+        cam_ring[i].clear = held;
+        spin_unlock(cam_ring_lock, save);
+        if (!held)
+            memset(cam_ring[i].buf, 0, cam_frame_words * sizeof(uint32_t));
+    }
+}
+
+bool cam_set_roi(uint32_t first_line, uint32_t line_count, uint32_t first_pixel, uint32_t pixel_count, uint8_t skip)
+{
+    if (skip != 1 && skip != 2 && skip != 4)
+        return false;
+    if (cam_capture_mode == CAM_CAPTURE_JPEG)
+        return false;
+    if (first_line + line_count > cam_sensor_h || first_pixel + pixel_count > cam_sensor_w || first_pixel > CAM_ROI_MAX_PIXELS)
+        return false;
+
+    uint32_t width = pixel_count / skip;
+    uint32_t height = line_count / skip;
+    if (width == 0 || height == 0 || (width % 4) != 0 || width > CAM_ROI_MAX_PIXELS)
+        return false;
+#if !(USE_COLOR_IMAGE)
+    // rdft2d() needs power of 2 (or 2^a 3^b 5^c with the mixed-radix FFT)
+    if (!cam_fft_size_ok(width, height))
+        return false;
+#endif
+    if (cam_pad_enabled && (width <= 2 * CAM_PAD_BORDER || height <= 2 * CAM_PAD_BORDER))
+        return false;
+
+    bool running = cam_running;
+    if (running)
+        free_cam(); // DMA_CAM_CMD_CH must be idle before rewriting commands
+
+    cam_roi_enabled = true;
+    cam_roi_first_line = first_line;
+    cam_roi_first_pixel = first_pixel;
+    cam_roi_skip = skip;
+    cam_frame_w = width;
+    cam_frame_h = height;
+    cam_update_line_cmd();
+    cam_load_program();
+    if (cam_pad_enabled)
+        cam_ring_clear();
+
+    if (running)
+    {
+        config_cam_buffer();
+        start_cam();
+    }
+    return true;
+}
+
+void cam_clear_roi()
+{
+    bool running = cam_running;
+    if (running)
+        free_cam();
+
+    cam_roi_enabled = false;
+    cam_roi_first_line = 0;
+    cam_roi_first_pixel = 0;
+    cam_roi_skip = 1;
+    cam_frame_w = cam_sensor_w;
+    cam_frame_h = cam_sensor_h;
+    cam_update_line_cmd();
+    cam_load_program();
+    if (cam_pad_enabled)
+        cam_ring_clear();
+
+    if (running)
+    {
+        config_cam_buffer();
+        start_cam();
+    }
+}
+
+bool cam_set_pad_capture(bool enable)
+{
+    if (enable && (cam_capture_mode == CAM_CAPTURE_RGB565 || cam_capture_mode == CAM_CAPTURE_JPEG ||
+                   cam_frame_w <= 2 * CAM_PAD_BORDER || cam_frame_h <= 2 * CAM_PAD_BORDER))
+        return false;
+
+    bool running = cam_running;
+    if (running)
+        free_cam();
+
+    cam_pad_enabled = enable;
+    cam_update_line_cmd();
+    cam_load_program();
+    if (cam_pad_enabled)
+        cam_ring_clear();
+
+    if (running)
+    {
+        config_cam_buffer();
+        start_cam();
+    }
+    return true;
+}
+
+void cam_get_frame_size(uint32_t *width, uint32_t *height)
+{
+    *width = cam_frame_w;
+    *height = cam_frame_h;
+}
+
+void cam_release_strip(cam_strip_t *strip)
+{
+    if (strip->slot < 0)
+        return;
+    cam_ring_release(strip->slot);
+    strip->slot = -1;
+}
+
+// drop the queued strips (and the slots they hold)
+static void cam_strip_flush(void)
+{
+    cam_strip_t st;
+    while (xQueueReceive(cam_strip_queue, &st, 0) == pdTRUE)
+        cam_release_strip(&st);
+}
+
+bool cam_set_strip_rows(uint32_t rows)
+{
+    if (rows > 0 && ((cam_frame_h % rows) != 0 || (cam_frame_h / rows) < 2))
+        return false;
+    if (rows > 0 && cam_capture_mode == CAM_CAPTURE_JPEG)
+        return false;
+
+    bool running = cam_running;
+    if (running)
+        free_cam();
+
+    cam_strip_rows = rows;
+    cam_strip_flush();
+
+    if (running)
+    {
+        cam_load_program(); // restart PIO from the frame start
+        config_cam_buffer();
+        start_cam();
+    }
+    return true;
+}
+
+bool cam_wait_strip(cam_strip_t *strip, TickType_t timeout)
+{
+    return (xQueueReceive(cam_strip_queue, strip, timeout) == pdTRUE);
+}
+
+void cam_get_strip_stats(uint32_t *dropped)
+{
+    *dropped = strips_dropped;
+}
+
+// hide all frames from consumers and wait until they release the slots they hold.
+static bool cam_ring_drain(uint32_t timeout_ms)
+{
+    absolute_time_t timeout = make_timeout_time_ms(timeout_ms);
+    bool held;
+
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        cam_ring[i].state = CAM_SLOT_FREE;
+        cam_ring[i].seq = 0;
+    }
+    spin_unlock(cam_ring_lock, save);
+
+    do
+    {
+        held = false;
+        for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+            held = held || (cam_ring[i].readers > 0);
+        if (!held)
+            return true;
+        sleep_ms(1);
+    } while (absolute_time_diff_us(get_absolute_time(), timeout) > 0);
+    return false;
+}
+
+bool cam_set_mode(uint32_t width, uint32_t height, uint8_t capture_mode, uint8_t frame_div)
+{
+    if (width == 0 || height == 0 || (width % 4) != 0 || width > CAM_MODE_MAX_W || height > CAM_MODE_MAX_H)
+        return false;
+    if (capture_mode > CAM_CAPTURE_JPEG || frame_div == 0)
+        return false;
+    if (capture_mode == CAM_CAPTURE_JPEG && cam_device != DEV_OV5642)
+        return false;
+#if !(USE_COLOR_IMAGE)
+    // depth estimation buffers are PAD_W x PAD_H, and rdft2d() needs power of 2 (see cam_fft_size_ok())
+    if (capture_mode == CAM_CAPTURE_JPEG || width > PAD_W || height > PAD_H || !cam_fft_size_ok(width, height))
+        return false;
+#endif
+    if (cam_pad_enabled && (capture_mode == CAM_CAPTURE_RGB565 || capture_mode == CAM_CAPTURE_JPEG ||
+                            width <= 2 * CAM_PAD_BORDER || height <= 2 * CAM_PAD_BORDER))
+        return false;
+
+    bool running = cam_running;
+    if (running)
+        free_cam();
+
+    // frames of the old mode can not be handed out any more
+    cam_strip_flush();
+    if (!cam_ring_drain(CAM_MODE_DRAIN_TIMEOUT_MS))
+    {
+        printf("cam_set_mode: frames are still held by consumers\n");
+        if (running)
+        {
+            config_cam_buffer();
+            start_cam();
+        }
+        return false;
+    }
+
+    // reallocate the slots first if the new frame does not fit (words per frame as in cam_load_program()).
+    // on failure nothing is changed, but the slots are new: rebuild the line lists of the current layout
+    uint32_t words = width * height / ((capture_mode == CAM_CAPTURE_GREEN || capture_mode == CAM_CAPTURE_Y8) ? 4 : 2);
+    if (words > cam_slot_words && !cam_ring_alloc(words))
+    {
+        printf("cam_set_mode: not enough memory for %ux%u\n", width, height);
+        cam_update_line_cmd();
+        if (cam_pad_enabled)
+            cam_ring_clear();
+        if (running)
+        {
+            config_cam_buffer();
+            start_cam();
+        }
+        return false;
+    }
+
+    // delta register set
+    if (capture_mode != cam_capture_mode)
+    {
+        if (capture_mode == CAM_CAPTURE_JPEG)
+            sccb_set_output_format(cam_device, SCCB_FMT_JPEG);
+        else if (capture_mode == CAM_CAPTURE_Y8)
+            sccb_set_output_format(cam_device, SCCB_FMT_YUV422);
+        else
+            sccb_set_output_format(cam_device, SCCB_FMT_RGB565);
+    }
+    if (width != cam_sensor_w || height != cam_sensor_h)
+        sccb_set_output_size(cam_device, width, height);
+    if (frame_div != cam_frame_div)
+        sccb_set_frame_div(cam_device, frame_div);
+    cam_sensor_w = width;
+    cam_sensor_h = height;
+    cam_capture_mode = capture_mode;
+    cam_frame_div = frame_div;
+
+    // ROI of the old image is meaningless. strips must divide the new height.
+    cam_roi_enabled = false;
+    cam_roi_first_line = 0;
+    cam_roi_first_pixel = 0;
+    cam_roi_skip = 1;
+    cam_frame_w = width;
+    cam_frame_h = height;
+    if (cam_strip_rows > 0 && ((height % cam_strip_rows) != 0 || (height / cam_strip_rows) < 2))
+        cam_strip_rows = 0;
+    cam_update_line_cmd(); // line lists point into the (re)allocated slots
+    cam_load_program();    // cam_frame_words of the new mode
+    if (cam_pad_enabled)
+        cam_ring_clear();
+
+    if (running)
+    {
+        config_cam_buffer();
+        start_cam();
+    }
+    return true;
+}
+
+// words per line of a frame
+static uint32_t cam_row_words(uint32_t width)
+{
+    return (cam_capture_mode == CAM_CAPTURE_RGB565) ? (width / 2) : (width / 4);
+}
+
+bool cam_set_depth_solver(int id)
+{
+    const depth_solver_t *ds = depth_solver(id);
+
+    if (ds == NULL)
+        return false;
+#if CAM_DEPTH_SOLVERS
+    // 作業領域は最初に選んだ時に確保する (FC は init_cam() で確保済み)
+    if (!ds->init(PAD_H, PAD_W))
+        return false;
+#else
+    if (id != DEPTH_SOLVER_FC)
+        return false;
+#endif
+    cam_depth_solver = id;
+    return true;
+}
+
+int cam_get_depth_solver(void)
+{
+    return cam_depth_solver;
+}
+
+// zero border of the software padding. Neumann-boundary solvers (DCT, MG) use the whole frame
+static uint32_t cam_pad_border(void)
+{
+    return depth_solver(cam_depth_solver)->periodic ? CAM_PAD_BORDER : 0;
 }
 
-void init_cam(uint8_t DEVICE_IS)
+// same as zeroPadImageWithBorder(src, dst, width, height, 1, border) for lines [row0, row0 + rows).
+// 'src' points to line 'row0'.
+static void pad_rows_with_border(const uint8_t *src, uint8_t *dst, uint32_t width, uint32_t height,
+                                 uint32_t row0, uint32_t rows, uint32_t border)
 {
-    sfe_pico_alloc_init();
-
-    // Initialize CAMERA
-    set_pwm_freq_kHz(20000, SYS_CLK_IN_KHZ, PIN_PWM0); // XCLK 24MHz -> OV5642,OV2640
-    sleep_ms(1000);
+    for (uint32_t y = row0; y < row0 + rows; y++, src += width)
+    {
+        uint8_t *d = dst + y * width;
+        if (y < border || y >= height - border)
+        {
+            memset(d, 0, width);
+            continue;
+        }
+        memset(d, 0, border);
+        memcpy(d + border, src + border, width - 2 * border);
+        memset(d + width - border, 0, border);
+    }
+}
 
-    sccb_init(DEVICE_IS, I2C1_SDA, I2C1_SCL, true); // sda,scl=(gp26,gp27). see 'sccb_if.c' and 'cam.h'
-    sleep_ms(3000);
+static normal_lut_t normal_lut; // L -> (p, q) のテーブル (L が変わった時だけ作り直す)
 
-    uint32_t offset_cam = pio_add_program(pio_cam, &picampinos_program);
-    uint32_t sm = 0; // pio_claim_unused_sm(pio_cam, true);
+// 光源 (LIGHT_INTERVAL フレーム毎か平均輝度が変わった時だけ推定し直す. USE_FIXED_LIGHT ではこの値のまま)
+static float light_L[3] = {0.7, 0.2, 1.0};
+static float light_k = 0.0f;
+static uint32_t light_age = 0;   // 前回の推定からのフレーム数
+static float light_mean = -1.0f; // 前回の推定時の平均輝度 (< 0: 未推定)
 
-    picampinos_program_init(pio_cam, sm_cam, offset_cam, CAM_BASE_PIN, 11); // VSYNC,HREF,PCLK,D[2:9] : total 11 pins
-    pio_sm_set_enabled(pio_cam, sm_cam, false);
-    pio_sm_clear_fifos(pio_cam, sm_cam);
-    pio_sm_restart(pio_cam, sm_cam);
-    pio_sm_set_enabled(pio_cam, sm_cam, true);
+// 全解像度の光源推定を融合カーネルの中で行うか
+#define FUSED_LIGHT (!USE_FIXED_LIGHT && LIGHT_DECIMATE == 1)
 
-    // init DMA
-    DMA_CAM_RD_CH0 = dma_claim_unused_channel(true);
-    DMA_CAM_RD_CH1 = dma_claim_unused_channel(true);
+// このフレームで光源を推定し直すか
+static bool light_due(const uint8_t *img, uint32_t width, uint32_t height)
+{
+#if (USE_FIXED_LIGHT)
+    return false;
+#else
+    float mean = mean_intensity_decimated(height, width, img, LIGHT_MEAN_STEP);
+    if (light_mean >= 0.0f && ++light_age < LIGHT_INTERVAL && fabsf(mean - light_mean) <= LIGHT_DRIFT)
+        return false;
+    light_age = 0;
+    light_mean = mean;
+    return true;
+#endif
+}
 
-    // IRQ settings
-    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH0, false);
-    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH1, false);
+#if (USE_FUSED_FRONT)
+static fused_front_t front; // 緑抽出 + パディング + 光源推定の途中経過 (RGB565)
+#endif
 
-    // printf("DMA_CH= %d,%d\n", DMA_CAM_RD_CH0, DMA_CAM_RD_CH1);
+// strip mode: green extraction and padding of each strip while the rest of the frame is arriving.
+// returns true when all the strips of a frame are in pad_ptr.
+// (USE_FUSED_FRONT: RGB565 strips also go through the gradient/light-source pass of 'front')
+static bool calc_image_strips(uint32_t *width, uint32_t *height, uint32_t *seq)
+{
+    cam_strip_t st;
+    uint32_t cur_seq = 0;
+    uint32_t next_row = 0;
 
-    // buffer of camera data is IMG_W * IMG_H * 2 bytes (RGB565 = 16 bits = 2 bytes)
-    // camera buffer on PSRAM
-    // | -- im1 --| -- im2 -- | gray image1 and 2
-    // |----------|-----------|
-    // | - pad1 - | - pad2 -- | padded image 1 and 2
-    // |----------|-----------|
-    // | -------- p1  ------- | real and imag of x-normal1
-    // | -------- q1  ------- | real and imag of y-normal1
-    // | -------- z1  ------- | real and imag of depth estimation1(reserved)
-    // |----------|-----------|
+    while (cam_wait_strip(&st, pdMS_TO_TICKS(100)))
+    {
+        // ストリップが抜けたフレームは捨てて、次のフレームの先頭から
+        if (st.first_row != next_row || (next_row > 0 && st.seq != cur_seq))
+        {
+            next_row = 0;
+            if (st.first_row != 0)
+            {
+                cam_release_strip(&st);
+                continue;
+            }
+        }
+        cur_seq = st.seq;
 
-    init_image_process(PAD_H, PAD_W);
-    // image1 and 2
-    cam_ptr = (uint32_t *)malloc(CAM_FUL_SIZE * sizeof(uint32_t) / 2);
-    cam_ptr1 = (uint32_t *)malloc(CAM_FUL_SIZE * sizeof(uint32_t) / 2);
-    gray_ptr = (uint8_t *)malloc(CAM_FUL_SIZE * 1 * sizeof(uint8_t));
-    // 262144
-    //  padded image 1 and 2
-    //  normal map1 and depth map1
-    pad_ptr = (uint8_t *)malloc((PAD_H * PAD_W) * sizeof(uint8_t));
-#if USE_REAL_FFT
-    p1_ptr = alloc_2d_float(PAD_H, PAD_W);
-    q1_ptr = alloc_2d_float(PAD_H, PAD_W);
-    d1_ptr = alloc_2d_float(PAD_H, PAD_W);
+        if (cam_capture_mode == CAM_CAPTURE_RGB565)
+        {
+#if (USE_FUSED_FRONT)
+            if (st.first_row == 0 && !fused_front_begin(&front, st.height, st.width, cam_pad_border(), FUSED_LIGHT))
+            {
+                cam_release_strip(&st);
+                continue;
+            }
+            fused_front_rgb565(&front, st.buf, st.rows, pad_ptr);
 #else
-    p1_ptr = alloc_2d_float(PAD_H, PAD_W * 2);
-    q1_ptr = alloc_2d_float(PAD_H, PAD_W * 2);
-    d1_ptr = alloc_2d_float(PAD_H, PAD_W * 2);
+            uint8_t *src = gray_ptr + st.first_row * st.width;
+            extract_green_from_uint32_array(st.buf, src, st.rows * st.width / 2);
+            pad_rows_with_border(src, pad_ptr, st.width, st.height, st.first_row, st.rows, cam_pad_border());
 #endif
-    if (!cam_ptr || !gray_ptr || !cam_ptr1 || !pad_ptr || !p1_ptr || !q1_ptr || !d1_ptr)
-    {
-        printf("Big block built in allocation failed\n");
-        // return 1;
-    }
+        }
+        else
+        {
+            // PIOがGreen(Y)のみ取り込み済み
+            pad_rows_with_border((uint8_t *)st.buf, pad_ptr, st.width, st.height, st.first_row, st.rows, cam_pad_border());
+        }
+        cam_release_strip(&st);
+        next_row = st.first_row + st.rows;
 
-    // todo: check psram size
-    memory_stats();
-    // init semaphore
-    sem_init(&fcmethod_semp, 1, 1);
-    sem_release(&fcmethod_semp);
+        if (st.last)
+        {
+            *width = st.width;
+            *height = st.height;
+            *seq = st.seq;
+            return true;
+        }
+    }
+    return false;
 }
 
-void config_cam_buffer()
+// time blocked on a queue of the pipeline
+static bool cam_pipe_receive(QueueHandle_t queue, void *item, TickType_t timeout, int stage)
 {
-    // ------------------ CAMERA READ: withDMA   --------------------------------
-
-    // disable IRQ
-    irq_set_enabled(DMA_IRQ_0, false);
-
-    // (2) 1st DMA Channel Config
-    dma_channel_config c;
-    c = get_cam_config(pio_cam, sm_cam, DMA_CAM_RD_CH1);
-    // trigger DMA_CAM_RD_CH0 when DMA_CAM_RD_CH1 completes. (ping-pong)
-    channel_config_set_chain_to(&c, DMA_CAM_RD_CH0);
-    dma_channel_configure(DMA_CAM_RD_CH1, &c,
-                          cam_ptr1,              // Destination pointer(back half of buffer)
-                          &pio_cam->rxf[sm_cam], // Source pointer
-                          CAM_FUL_SIZE / 2,      // Number of transfers
-                          false                  // Don't Start yet
-    );
-
-    // (1) 0th DMA Channel Config
-    c = get_cam_config(pio_cam, sm_cam, DMA_CAM_RD_CH0);
-    // trigger DMA_CAM_RD_CH1 when DMA_CAM_RD_CH0 completes.
-    channel_config_set_chain_to(&c, DMA_CAM_RD_CH1);
-    dma_channel_configure(DMA_CAM_RD_CH0, &c,
-                          cam_ptr,               // Destination pointer(front half of buffer)
-                          &pio_cam->rxf[sm_cam], // Source pointer
-                          CAM_FUL_SIZE / 2,      // Number of transfers
-                          false                  // Don't Start yet
-    );
-
-    // IRQ settings
-    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH1, true);
-    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH0, true);
-    irq_set_exclusive_handler(DMA_IRQ_0, cam_handler);
-    irq_set_enabled(DMA_IRQ_0, true);
+    uint32_t t = time_us_32();
+    bool ok = (xQueueReceive(queue, item, timeout) == pdTRUE);
+    cam_stage[stage].wait_us += time_us_32() - t;
+    return ok;
 }
 
+// stage A: frame -> p, q of a free gradient buffer -> stage B
 void calc_image(void)
 {
-    static int32_t tim32;
-    // 光源推定
-    float L[3] = {0.7, 0.2, 1.0};
-    float k;
+    static uint32_t last_seq = 0;
+    static cam_grad_t *g = NULL; // 空いている勾配バッファ (フレームが来るまで持っておく)
     uint32_t *b;
-    b = (psram_access == 0) ? cam_ptr : cam_ptr1;
+    cam_frame_t frm;
+    uint32_t w, h, seq;
+    uint8_t *img = pad_ptr; // padded image for normal estimation
+    bool fused = false;     // true: 光源推定の積算は済み (fused_front_light() だけ)
+    bool normals = false;   // true: p, q は推定済み
+    uint32_t t0;
 #if (USE_COLOR_IMAGE)
 
 #else
-    extract_green_from_uint32_array(b, gray_ptr, CAM_FUL_SIZE / 2); // 2つのRGB565(16bit)を32bitパッキングされたデータから2つ分のGreen(uint8_t[])データを取得している
-
-    zeroPadImageWithBorder(gray_ptr, pad_ptr, IMG_W, IMG_H, 1, 10); // パディング：上下左右それぞれ20pix
-                                                                    // zeroPadImage(gray_ptr, pad_ptr, IMG_W, IMG_H, 1, PAD_W, PAD_H); // ゼロパディング
-
-    estimate_lightsource_and_normal(PAD_W, PAD_H, pad_ptr, p1_ptr, q1_ptr, L, &k);
-    // estimate_normal(PAD_W, PAD_H, pad_ptr, p1_ptr, q1_ptr, L);
+    // B が勾配バッファを返すまで待つ (B が遅い間はフレームを取らない. 取らなかったフレームはリングで捨てられる)
+    if (g == NULL && !cam_pipe_receive(cam_grad_free, &g, portMAX_DELAY, CAM_STAGE_NORMAL))
+        return;
+    float_t **p1_ptr = g->p;
+    float_t **q1_ptr = g->q;
 
-    // セマフォの取得
-    sem_acquire_blocking(&fcmethod_semp);
+    t0 = time_us_32(); // (ストリップ: 最初のストリップを待つ時間から)
+    if (cam_strips > 1)
+    {
+        // ストリップ毎に緑抽出・パディング済み(キャプチャと並行)
+        if (!calc_image_strips(&w, &h, &seq))
+            return;
+        fused = USE_FUSED_FRONT && FUSED_LIGHT && (cam_capture_mode == CAM_CAPTURE_RGB565);
+    }
+    else
     {
-        // タスク排他処理
-        fcmethod(PAD_W, PAD_H, q1_ptr, p1_ptr, d1_ptr);
+        // 新しいフレームが完成するまで待つ (割り込みからの通知. 同じフレームは2度処理しない)
+        if (!cam_wait_frame(&frm, last_seq, pdMS_TO_TICKS(CAM_FRAME_WAIT_MS)))
+            return;
+        t0 = time_us_32();
+        last_seq = frm.seq;
+        seq = frm.seq;
+        b = frm.buf;
+        // ROI設定時はフレームが小さい(FFTサイズも小さくなる)
+        w = frm.width;
+        h = frm.height;
+#if (USE_FUSED_FRONT)
+        if (cam_capture_mode == CAM_CAPTURE_RGB565 && fused_front_begin(&front, h, w, cam_pad_border(), FUSED_LIGHT))
+        {
+            // 緑抽出・パディング・勾配を1パスで (RGB565 は1回だけ読む)
+            fused_front_rgb565(&front, b, h, pad_ptr);
+            cam_release_frame(&frm);
+            fused = FUSED_LIGHT;
+        }
+        else
+#endif
+        if (cam_capture_mode == CAM_CAPTURE_RGB565)
+        {
+            extract_green_from_uint32_array(b, gray_ptr, w * h / 2); // 2つのRGB565(16bit)を32bitパッキングされたデータから2つ分のGreen(uint8_t[])データを取得している
+            cam_release_frame(&frm);                                 // フレームはもう不要。DMAに返却
+            zeroPadImageWithBorder(gray_ptr, pad_ptr, w, h, 1, cam_pad_border()); // パディング：上下左右それぞれ10pix (DCT, MG は無し)
+        }
+        else if (cam_pad_enabled)
+        {
+            // DMAがパディング済みの配置で書き込み済み。コピー不要
+            img = (uint8_t *)b;
+        }
+        else
+        {
+            // PIOがGreen(Y)のみ取り込み済み。抽出は不要
+            zeroPadImageWithBorder((uint8_t *)b, pad_ptr, w, h, 1, cam_pad_border());
+            cam_release_frame(&frm);
+        }
+    }
+    // zeroPadImage(gray_ptr, pad_ptr, IMG_W, IMG_H, 1, PAD_W, PAD_H); // ゼロパディング
 
-        // タスク処理が完了したらセマフォを解放
-        sem_release(&fcmethod_semp);
+    // 光源推定は時々 (間引き画像で). それ以外のフレームは L 固定のテーブルで法線だけ (estimate_normal() と同じ)
+    if (light_due(img, w, h))
+    {
+#if (LIGHT_DECIMATE > 1)
+        estimate_lightsource_decimated(h, w, img, LIGHT_DECIMATE, light_L, &light_k);
+#else
+#if (USE_FUSED_FRONT)
+        if (fused)
+            fused_front_light(&front, light_L, &light_k);
+        else
+#endif
+        {
+            estimate_lightsource_and_normal(h, w, img, p1_ptr, q1_ptr, light_L, &light_k);
+            normals = true;
+        }
+#endif
     }
+    if (!normals)
+    {
+        normal_lut_update(&normal_lut, light_L);
+        estimate_normal_lut(h, w, img, p1_ptr, q1_ptr, &normal_lut);
+    }
+    if (img != pad_ptr)
+        cam_release_frame(&frm); // 法線推定が終わったのでフレームをDMAに返却
+
+    g->width = w;
+    g->height = h;
+    g->seq = seq;
+    memcpy(g->L, light_L, sizeof(g->L));
+    g->k = light_k;
+    cam_stage[CAM_STAGE_NORMAL].busy_us += time_us_32() - t0;
+    cam_stage[CAM_STAGE_NORMAL].frames++;
+
+    // B へ (キューの長さ = バッファ数なので待たない)
+    xQueueSend(cam_grad_full, &g, portMAX_DELAY);
+    g = NULL;
+#endif
+}
+
+// stage B: p, q -> depth map -> stage C
+void calc_depth(void)
+{
+    static int32_t tim32;
+    cam_grad_t *g;
+    cam_depth_t *d;
+    uint32_t t0;
+
+    if (!cam_pipe_receive(cam_grad_full, &g, portMAX_DELAY, CAM_STAGE_DEPTH))
+        return;
+    d = cam_depth_write; // B だけが使う (C は送信中でも別の面)
+    uint32_t w = g->width;
+    uint32_t h = g->height;
+
+    t0 = time_us_32();
+#if USE_REAL_FFT && USE_FC_FIXED
+    fcmethod_fixed(h, w, g->q, g->p, d->d, &d->exp);
+#elif USE_REAL_FFT && USE_FC_PACKED && USE_FC_HALF
+    fcmethod_packed_half(h, w, g->q, g->p, d->d);
+#elif CAM_DEPTH_SOLVERS
+    // FC (fcmethod_packed()), DCT or MG. cam_set_depth_solver() で切り替え
+    // DCT は2のべき乗のサイズだけ (混合基数のサイズは FC か MG)
+    const depth_solver_t *ds = depth_solver(cam_depth_solver);
+    if (ds->solve(h, w, g->q, g->p, d->d) < 0)
+        printf("depth solver %s: %ux%u is not supported\n", ds->name, w, h);
+#else
+    fcmethod(h, w, g->q, g->p, d->d);
+#endif
+    d->width = w;
+    d->height = h;
+    d->seq = g->seq;
+    memcpy(d->L, g->L, sizeof(d->L));
+    d->k = g->k;
+    cam_stage[CAM_STAGE_DEPTH].busy_us += time_us_32() - t0;
+    cam_stage[CAM_STAGE_DEPTH].frames++;
+
+    // 勾配バッファは A へ (バッファ数以上は入らないので待たない)
+    xQueueSend(cam_grad_free, &g, portMAX_DELAY);
+
+    // 深度マップを公開: 書き終えた面と最新の面を入れ替えるだけ (C の送信を待たない)
+    uint32_t save = spin_lock_blocking(cam_depth_lock);
+    if (cam_depth_fresh)
+        cam_stage[CAM_STAGE_SEND].dropped++; // C が取る前に新しい深度マップで置き換えた
+    cam_depth_write = cam_depth_latest;
+    cam_depth_latest = d;
+    cam_depth_fresh = true;
+    spin_unlock(cam_depth_lock, save);
 
     /*
     // printf()で深度を確認したい場合はここのコメントアウトを解除
@@ -213,16 +1527,52 @@ void calc_image(void)
             for (int j = 0; j < IMG_W; j++)
             {
                 // int index = i * IMG_W + j;
-                printf("%.2f,", d1_ptr[i][2 * j]); // 実数部のみ抽出
+                printf("%.2f,", d->d[i][2 * j]); // 実数部のみ抽出
             }
             printf("\n");
         }
         printf("];\n");
     */
 
-    printf(".....%dmsec\n", (int)((time_us_32() - tim32) / 1e3));
+    printf(".....%dmsec (frame #%u, dropped %u)\n", (int)((time_us_32() - tim32) / 1e3), d->seq, frames_dropped);
     tim32 = time_us_32();
-#endif
+}
+
+void cam_get_pipe_stats(cam_stage_stats_t st[CAM_STAGES], uint32_t *elapsed_us)
+{
+    for (int32_t i = 0; i < CAM_STAGES; i++)
+    {
+        st[i].frames = cam_stage[i].frames;
+        st[i].busy_us = cam_stage[i].busy_us;
+        st[i].wait_us = cam_stage[i].wait_us;
+        st[i].dropped = cam_stage[i].dropped;
+    }
+    fft_helper_stats_t h;
+    fft_helper_get_stats(&h);
+    st[CAM_STAGE_NORMAL].helper_us = h.a_ready_us - cam_helper_t0.a_ready_us;
+    st[CAM_STAGE_NORMAL].helper_woke_us = h.a_woke_us - cam_helper_t0.a_woke_us;
+    st[CAM_STAGE_DEPTH].helper_us = h.busy_us - cam_helper_t0.busy_us;
+    st[CAM_STAGE_DEPTH].helper_woke_us = 0;
+    st[CAM_STAGE_SEND].helper_us = 0;
+    st[CAM_STAGE_SEND].helper_woke_us = 0;
+    st[CAM_STAGE_NORMAL].queued = uxQueueMessagesWaiting(cam_grad_free);
+    st[CAM_STAGE_DEPTH].queued = uxQueueMessagesWaiting(cam_grad_full);
+    st[CAM_STAGE_SEND].queued = cam_depth_fresh ? 1 : 0;
+    *elapsed_us = time_us_32() - cam_stage_t0;
+}
+
+void cam_reset_pipe_stats(void)
+{
+    for (int32_t i = 0; i < CAM_STAGES; i++)
+    {
+        cam_stage[i].frames = 0;
+        cam_stage[i].busy_us = 0;
+        cam_stage[i].wait_us = 0;
+        cam_stage[i].queued = 0;
+        cam_stage[i].dropped = 0;
+    }
+    fft_helper_get_stats(&cam_helper_t0);
+    cam_stage_t0 = time_us_32();
 }
 
 void start_cam()
@@ -230,11 +1580,30 @@ void start_cam()
 
     // Start DMA
     dma_channel_abort(DMA_CAM_RD_CH0);
-    dma_start_channel_mask(1u << DMA_CAM_RD_CH0);
+    if (cam_pad_enabled)
+        dma_start_channel_mask(1u << DMA_CAM_RD_CH1); // control channel starts CH0
+    else
+        dma_start_channel_mask(1u << DMA_CAM_RD_CH0);
 
     // camera transfer settings(for video)
-    pio_sm_put_blocking(pio_cam, sm_cam, 0);                      // X=0 : reserved
-    pio_sm_put_blocking(pio_cam, sm_cam, (CAM_FUL_SIZE / 2 - 1)); // Y: total words in an image
+    if (cam_capture_mode == CAM_CAPTURE_JPEG)
+    {
+        // no parameters: the frame length is decided by the sensor
+    }
+    else if (cam_line_cmd)
+    {
+        // ROI: line commands of the 1st frame
+        dma_channel_start(DMA_CAM_CMD_CH);
+    }
+    else
+    {
+        pio_sm_put_blocking(pio_cam, sm_cam, 0); // X=0 : reserved
+        if (cam_capture_mode == CAM_CAPTURE_RGB565)
+            pio_sm_put_blocking(pio_cam, sm_cam, (cam_frame_words - 1)); // Y: total words in an image
+        else
+            pio_sm_put_blocking(pio_cam, sm_cam, (cam_frame_w * cam_frame_h - 1)); // Y: total pixels in an image
+    }
+    cam_running = true;
 }
 
 void uartout_cam()
@@ -243,52 +1612,63 @@ void uartout_cam()
     printf("!srt\r\n");
     sleep_ms(30);
 
-    int32_t *b;
-    b = (psram_access == 0) ? cam_ptr1 : cam_ptr;
+    uint32_t *b;
+    cam_frame_t frm;
+    if (!cam_acquire_frame(&frm, 0))
+        return;
+    b = frm.buf;
+    uint32_t row_words = cam_row_words(frm.width); // IMG_W/2(RGB565) or IMG_W/4(8bit)
+    uint32_t rows = frm.height;
+    if (cam_capture_mode == CAM_CAPTURE_JPEG)
+    {
+        // JPEG: (bytes + 3) / 4 words in a row
+        row_words = (frm.length + 3) / 4;
+        rows = 1;
+    }
 
-    for (uint32_t h = 0; h < IMG_H; h++)
+    for (uint32_t h = 0; h < rows; h++)
     {
-        for (uint32_t i = 0; i < (IMG_W / 2); i++)
+        for (uint32_t i = 0; i < row_words; i++)
         {
-            printf("0x%08X\r\n", b[(h * (IMG_W / 2)) + i]);
+            printf("0x%08X\r\n", b[(h * row_words) + i]);
         }
     }
+    cam_release_frame(&frm);
 }
 
 #if USE_100BASE_FX
 void sfp_cam()
 {
-    static int32_t iot_addr;
+    static uint32_t last_seq = 0;
     sfp_hw_init(pio_sfp);
 
     while (1)
     {
 
-        int32_t *b;
+        uint32_t *b;
         uint32_t resp;
-        b = cam_ptr + iot_addr;
+        cam_frame_t frm;
+        if (!cam_acquire_frame(&frm, last_seq))
+            continue;
+        last_seq = frm.seq;
+        b = frm.buf;
 
         // send header
         // frame start:
         // '0xdeadbeef' + row_size_in_words(unit is in words(not bytes)) + columb_size_in_words(total blocks per frame)
-        uint32_t a[4] = {0xdeadbeef, IMG_H, IMG_W * 2 / sizeof(uint32_t), IMG_H};
+        uint32_t row_words = cam_row_words(frm.width);
+        uint32_t a[4] = {0xdeadbeef, frm.height, row_words, frm.height};
 
         sfp_send(&a, sizeof(uint32_t) * 4);
 
         // sem_release(&psram_sem);
-        for (uint32_t i = 0; i < CAM_FUL_SIZE / sizeof(uint32_t); i += (IMG_W / 2))
+        for (uint32_t i = 0; i < row_words * frm.height; i += row_words)
         {
             // printf("0x%08X\r\n",b[i]);
-            sfp_send_with_header(0xbeefbeef, (i / (IMG_W / 2)) + 1, 1, (IMG_W / 2), &(b[i]), sizeof(uint32_t) * (IMG_W / 2));
+            sfp_send_with_header(0xbeefbeef, (i / row_words) + 1, 1, row_words, &(b[i]), sizeof(uint32_t) * row_words);
         }
 
-        // increment iot sram's address
-        iot_addr = iot_addr + CAM_FUL_SIZE;
-
-        if (iot_addr > CAM_TOTAL_LEN - 1)
-        {
-            iot_addr = 0;
-        }
+        cam_release_frame(&frm);
         // send dummy data
 
         a[0] = 0xdeaddead;
@@ -297,22 +1677,77 @@ void sfp_cam()
 }
 #endif
 
-void rj45_cam(void)
+#if (USE_COLOR_IMAGE)
+// JPEG: a frame is sent in as many packets as it needs (words of the last packet are fewer).
+// frame start: '0xdeadbeef' + packets + words_per_packet + packets + bytes of the frame
+// next udp packet: '0xbeefbeef' + packet number(from 1) + 1 + words in the packet + data....
+static void rj45_cam_jpeg(cam_frame_t *frm, uint8_t *udp_payload, uint32_t *tx_buf)
 {
+    const uint32_t pkt_words = (DEF_UDP_PAYLOAD_SIZE - 4 * sizeof(uint32_t)) / sizeof(uint32_t);
+    uint32_t frame_words = (frm->length + 3) / 4;
+    uint32_t packets = (frame_words + pkt_words - 1) / pkt_words;
+    uint32_t *b = frm->buf;
+
+    uint32_t a[5] = {0xdeadbeef, packets, pkt_words, packets, frm->length};
+    memset(udp_payload, 0, DEF_UDP_PAYLOAD_SIZE);
+    memcpy(udp_payload, a, sizeof(a));
+    udp_packet_gen_10base(tx_buf, udp_payload);
+    eth_tx_data(tx_buf, DEF_UDP_BUF_SIZE);
+
+    for (uint32_t i = 0; i < packets; i++)
+    {
+        uint32_t words = (frame_words - i * pkt_words < pkt_words) ? (frame_words - i * pkt_words) : pkt_words;
+        uint32_t c[] = {
+            0xbeefbeef,
+            i + 1,
+            1,
+            words};
+
+        memcpy(udp_payload, c, 4 * sizeof(uint32_t));
+        memcpy(udp_payload + 4 * sizeof(uint32_t), b, sizeof(uint32_t) * words);
+        b += words;
+        udp_packet_gen_10base(tx_buf, udp_payload);
+        eth_tx_data(tx_buf, DEF_UDP_BUF_SIZE);
+    }
+
+    a[0] = 0xdeaddead;
+    memcpy(udp_payload, a, sizeof(a));
+    udp_packet_gen_10base(tx_buf, udp_payload);
+    eth_tx_data(tx_buf, DEF_UDP_BUF_SIZE);
+}
+#endif
 
-    uint8_t udp_payload1[DEF_UDP_PAYLOAD_SIZE] = {0};
-    uint32_t tx_buf_udp1[DEF_UDP_BUF_SIZE + 1] = {0};
+void rj45_cam(void)
+{
+    if (!udp_payload1 || !tx_buf_udp1)
+        return;
 #if (USE_COLOR_IMAGE)
 
+    static uint32_t last_seq = 0;
     uint32_t *b;
     uint32_t resp;
+    cam_frame_t frm;
     // RGB565のデータの場合
-    b = cam_ptr;
+    // 送信中のフレームはDMAに上書きされない
+    if (!cam_acquire_frame(&frm, last_seq))
+        return;
+    last_seq = frm.seq;
+    if (cam_capture_mode == CAM_CAPTURE_JPEG)
+    {
+        // 圧縮済みフレーム(可変長)。壊れたフレームは送らない
+        if (frm.length > 0)
+            rj45_cam_jpeg(&frm, udp_payload1, tx_buf_udp1);
+        cam_release_frame(&frm);
+        return;
+    }
+    b = frm.buf;
+    uint32_t row_words = cam_row_words(frm.width); // IMG_W/2(RGB565) or IMG_W/4(8bit)
+    uint32_t frame_words = row_words * frm.height;
 
     // send header
     // frame start:
     // '0xdeadbeef' + row_size_in_words(unit is in words(not bytes)) + column_size_in_words(total blocks per frame)
-    uint32_t a[4] = {0xdeadbeef, IMG_H, IMG_W / 2, IMG_H};
+    uint32_t a[4] = {0xdeadbeef, frm.height, row_words, frm.height};
 
     // make image header
     udp_packet_gen_10base(tx_buf_udp1, (uint8_t *)&a);
@@ -320,18 +1755,18 @@ void rj45_cam(void)
     // send image header
     eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
 
-    for (uint32_t i = 0; i < CAM_FUL_SIZE / 2; i += (IMG_W / 2))
+    for (uint32_t i = 0; i < frame_words; i += row_words)
     {
         // printf("0x%08X\r\n",b[i]);
         uint32_t c[] = {
             0xbeefbeef,
-            (i / (IMG_W / 2)) + 1,
+            (i / row_words) + 1,
             1,
-            (IMG_W / 2)};
+            row_words};
 
         memcpy(udp_payload1, c, 4 * sizeof(uint32_t));
-        memcpy(udp_payload1 + 4 * sizeof(uint32_t), b, sizeof(int32_t) * (IMG_W / 2));
-        b += (IMG_W / 2);
+        memcpy(udp_payload1 + 4 * sizeof(uint32_t), b, sizeof(int32_t) * row_words);
+        b += row_words;
         udp_packet_gen_10base(tx_buf_udp1, udp_payload1);
         eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
     }
@@ -342,63 +1777,96 @@ void rj45_cam(void)
 
     // send image header
     eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
+    cam_release_frame(&frm);
 
 #else
     // Float型の場合
-    float_t *b;
+    // stage C: B が最後に求めた深度マップを送る. 新しいものが無ければ待たずに戻る (eth_main() を回す)
+    cam_depth_t *d;
+    uint32_t t0;
+
+    if (!cam_depth_fresh)
+        return;
+    // 送り終えた面と最新の面を入れ替える. 送信中の面に B は書かない
+    uint32_t save = spin_lock_blocking(cam_depth_lock);
+    d = cam_depth_latest;
+    cam_depth_latest = cam_depth_send;
+    cam_depth_send = d;
+    cam_depth_fresh = false;
+    spin_unlock(cam_depth_lock, save);
+    t0 = time_us_32();
 
     // send header
     // frame start:
-    // '0xdeadbeef' + row_size_in_words(unit is in words(not bytes)) + column_size_in_words(total blocks per frame)
-    uint32_t a[4] = {0xdeadbeef, IMG_H, IMG_W, IMG_H};
-
-    // セマフォの取得。できなかったら待たずに退散。
-    if (sem_try_acquire(&fcmethod_semp))
-    {
-
-        // sem_release(&fcmethod_semp); // タスク完了を待たずにセマフォを解放
-        //  make image header
-        udp_packet_gen_10base(tx_buf_udp1, (uint8_t *)&a);
+    // '0xdeadbeef' + row_size_in_words(unit is in words(not bytes)) + column_size_in_words + total blocks per frame
+    // + light source Lx, Ly, Lz, k (float)
+    // a row wider than CAM_DEPTH_PKT_FLOATS is sent in several blocks (column offset in the block header)
+    uint32_t blocks = (d->width + CAM_DEPTH_PKT_FLOATS - 1) / CAM_DEPTH_PKT_FLOATS;
+    uint32_t a[8] = {0xdeadbeef, d->height, d->width, d->height * blocks};
+    memcpy(&a[4], d->L, sizeof(d->L));
+    memcpy(&a[7], &d->k, sizeof(d->k));
+
+    //  make image header
+    udp_packet_gen_10base(tx_buf_udp1, (uint8_t *)&a);
 
-        // send image header
-        eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
+    // send image header
+    eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
 
-        for (uint32_t i = 0; i < IMG_H; i++)
+    for (uint32_t i = 0; i < d->height; i++)
+    {
+        for (uint32_t j0 = 0; j0 < d->width; j0 += CAM_DEPTH_PKT_FLOATS)
         {
+            uint32_t n = d->width - j0;
+            if (n > CAM_DEPTH_PKT_FLOATS)
+                n = CAM_DEPTH_PKT_FLOATS;
+            // row number, column number (1 origin), data length
             uint32_t c[] = {
                 0xbeefbeef,
                 i + 1,
-                1,
-                (IMG_W)};
+                j0 + 1,
+                n};
 
             memcpy(udp_payload1, c, 4 * sizeof(uint32_t));
 
             // ヘッダサイズ分、ポインタをずらす
             float_t *st_posfl = (float_t *)(udp_payload1 + 4 * sizeof(uint32_t));
 
-#if USE_REAL_FFT
-            // USE_REAL_FFTが有効な場合、そのままの並びでIMG_W個コピー可能であればmemcpy一発でOK
-            memcpy(st_posfl, d1_ptr[i], IMG_W * sizeof(float_t));
+#if USE_REAL_FFT && USE_FC_FIXED
+            // Q15の深度はfloatに戻して送る(受信側はそのまま)
+            for (uint32_t j = 0; j < n; j++)
+            {
+                st_posfl[j] = ldexpf((float_t)d->d[i][j0 + j], d->exp);
+            }
+#elif USE_REAL_FFT && USE_FC_PACKED && USE_FC_HALF
+            // 16bitの深度はfloatに戻して送る
+            for (uint32_t j = 0; j < n; j++)
+            {
+                st_posfl[j] = half_to_float(d->d[i][j0 + j]);
+            }
+#elif USE_REAL_FFT
+            // USE_REAL_FFTが有効な場合、そのままの並びなのでmemcpy一発でOK
+            memcpy(st_posfl, &d->d[i][j0], n * sizeof(float_t));
 #else
             // USE_REAL_FFTが無効な場合は2倍インデックスでアクセス
-            for (int j = 0; j < IMG_W; j++)
+            for (uint32_t j = 0; j < n; j++)
             {
-                st_posfl[j] = d1_ptr[i][2 * j];
+                st_posfl[j] = d->d[i][2 * (j0 + j)];
             }
 #endif
 
             udp_packet_gen_10base(tx_buf_udp1, udp_payload1);
             eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
         }
+    }
 
-        a[0] = 0xdeaddead;
-        // make image header
-        udp_packet_gen_10base(tx_buf_udp1, (uint8_t *)&a);
+    a[0] = 0xdeaddead;
+    // make image header
+    udp_packet_gen_10base(tx_buf_udp1, (uint8_t *)&a);
 
-        // send image header
-        eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
-        sem_release(&fcmethod_semp);
-    }
+    // send image header
+    eth_tx_data(tx_buf_udp1, DEF_UDP_BUF_SIZE);
+    cam_stage[CAM_STAGE_SEND].busy_us += time_us_32() - t0;
+    cam_stage[CAM_STAGE_SEND].frames++;
 #endif
 }
 
@@ -407,69 +1875,290 @@ void free_cam()
 
     // Disable IRQ settings
     irq_set_enabled(DMA_IRQ_0, false);
+    irq_set_enabled(pio_get_irq_num(pio_cam, 0), false);
+    pio_set_irq0_source_enabled(pio_cam, pis_interrupt0, false);
     dma_channel_set_irq0_enabled(DMA_CAM_RD_CH1, false);
     dma_channel_set_irq0_enabled(DMA_CAM_RD_CH0, false);
     dma_channel_abort(DMA_CAM_RD_CH1);
     dma_channel_abort(DMA_CAM_RD_CH0);
+    dma_channel_abort(DMA_CAM_CMD_CH);
+    pio_sm_set_enabled(pio_cam, sm_cam, false);
+    cam_running = false;
 }
 
 /// camera dma config
-dma_channel_config get_cam_config(PIO pio, uint32_t sm, uint32_t dma_chan)
+dma_channel_config get_cam_config(PIO pio, uint32_t sm, uint32_t dma_chan, enum dma_channel_transfer_size size)
 {
     dma_channel_config c = dma_channel_get_default_config(dma_chan);
     channel_config_set_read_increment(&c, false);
     channel_config_set_write_increment(&c, true);
-    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_transfer_data_size(&c, size);
     channel_config_set_dreq(&c, pio_get_dreq(pio, sm, false));
     return c;
 }
 
-void cam_handler()
+// pick the next slot for DMA: free slot first, then the oldest complete frame.
+// must be called with cam_ring_lock held.
+static int32_t cam_ring_next_slot(void)
+{
+    int32_t next = -1;
+    for (int32_t i = 0; i < CAM_RING_SLOTS; i++)
+    {
+        if (cam_ring[i].state == CAM_SLOT_WRITING || cam_ring[i].readers > 0)
+            continue;
+        if (next < 0 || cam_ring[i].seq < cam_ring[next].seq)
+            next = i;
+    }
+    return next;
+}
+
+// publish a complete frame. must be called with cam_ring_lock held.
+static void cam_ring_publish(int32_t slot, uint32_t now)
+{
+    cam_slot_t *done = &cam_ring[slot];
+    done->width = cam_frame_w;
+    done->height = cam_frame_h;
+    done->words = cam_frame_words;
+    done->length = cam_frame_words * sizeof(uint32_t);
+    done->seq = ++frame_seq;
+    done->timestamp_us = now;
+    done->taken = false;
+    done->state = CAM_SLOT_READY;
+    cam_frame_event = CAM_FRAME_EVENT(done->seq, slot);
+    cam_frame_event_pending = true;
+}
+
+// take the next slot for DMA and mark it WRITING. -1: every slot is held by consumers (the next frame
+// goes to the sink). must be called with cam_ring_lock held.
+static int32_t cam_ring_arm_next(void)
+{
+    int32_t next = cam_ring_next_slot();
+    if (next >= 0)
+    {
+        if (cam_ring[next].state == CAM_SLOT_READY && !cam_ring[next].taken)
+            frames_dropped++;
+        cam_ring[next].state = CAM_SLOT_WRITING;
+    }
+    return next;
+}
+
+// a frame written to 'slot' is complete: publish it, or drop it if it went to the sink (slot -1).
+// must be called with cam_ring_lock held.
+static void cam_ring_complete(int32_t slot, uint32_t now)
 {
-    static uint32_t num_of_call_this = 0;
-    static uint32_t *b;
-    uint32_t dma_chan;
+    if (slot < 0)
+    {
+        frame_seq++;
+        frames_dropped++;
+        return;
+    }
+    cam_ring_publish(slot, now);
+}
 
-    if (num_of_call_this > 0)
+// point the writes of 'dma_chan' at 'offset' words into 'slot', or at the sink (slot -1, not incremented).
+// pad capture: the address comes from the line list (see 'cam_pad_line_list()'), only the increment is set.
+static void cam_dma_arm(uint32_t dma_chan, int32_t slot, uint32_t offset)
+{
+    if (slot < 0)
+    {
+        hw_clear_bits(&dma_hw->ch[dma_chan].al1_ctrl, DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS);
+        if (!cam_pad_enabled)
+            dma_channel_set_write_addr(dma_chan, &cam_dma_sink, false);
         return;
-    num_of_call_this++;
+    }
+    hw_set_bits(&dma_hw->ch[dma_chan].al1_ctrl, DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS);
+    if (!cam_pad_enabled)
+        dma_channel_set_write_addr(dma_chan, cam_ring[slot].buf + offset, false);
+}
+
+// pad capture: line list of 'slot' (slot -1: every line to the sink)
+static uint32_t *cam_pad_line_list(int32_t slot)
+{
+    return (slot < 0) ? cam_pad_sink_list : cam_pad_list[slot];
+}
 
-    // sem_acquire_blocking(&psram_sem);
-    // iot_sram_write(pio_iot, b, iot_addr, CAM_BUF_HALF, DMA_IOT_WR_CH); // pio, sm, buffer, start_address, length
-    // sem_release(&psram_sem);
+// strip mode: a strip is complete. hand it to consumers with a reader on its slot (strip->slot < 0: nothing
+// to hand), publish the frame on its last strip, and arm the strip next to the other channel's(2 strips ahead).
+// returns true on the last strip of a frame. must be called with cam_ring_lock held.
+static bool cam_strip_done(int32_t ch, uint32_t dma_chan, uint32_t now, cam_strip_t *strip)
+{
+    uint32_t strip_words = cam_frame_words / cam_strips;
+    int32_t slot = dma_slot[ch];
+    uint32_t idx = dma_strip[ch];
+    bool last = (idx == cam_strips - 1);
 
-    // increment iot sram's address
-    // iot_addr = iot_addr + CAM_BUF_HALF;
-    uint32_t triggered_dma = dma_hw->ints0; // DMA_IRQ_0に関連する割り込みステータス
+    strip->slot = slot;
+    if (slot >= 0)
+    {
+        strip->buf = cam_ring[slot].buf + idx * strip_words;
+        strip->seq = frame_seq + 1;
+        strip->width = cam_frame_w;
+        strip->height = cam_frame_h;
+        strip->first_row = idx * cam_strip_rows;
+        strip->rows = cam_strip_rows;
+        strip->last = last;
+        cam_ring[slot].readers++; // released by cam_release_strip()
+    }
+
+    if (last)
+        cam_ring_complete(slot, now);
 
-    if (triggered_dma & (1u << DMA_CAM_RD_CH0))
+    if (arm_strip == 0)
     {
-        // Triggered by DMA_CAM_RD_CH0
-        // printf("DMA channel 0 triggered the interrupt.\n");
-        dma_chan = DMA_CAM_RD_CH0;
-        psram_access = 0;
-        b = cam_ptr;
-        // gpio_put(25, 1);
+        // 1st strip of the next frame. the frame in progress is still WRITING.
+        // slots with queued strips have readers, so DMA never writes a strip a consumer may be reading.
+        // if all the other slots are held, the next frame goes to the sink.
+        arm_slot = cam_ring_arm_next();
     }
+    dma_slot[ch] = arm_slot;
+    dma_strip[ch] = arm_strip;
+    cam_dma_arm(dma_chan, arm_slot, arm_strip * strip_words);
+    if (++arm_strip == cam_strips)
+        arm_strip = 0;
+
+    return last;
+}
+
+// JPEG: restart CH0 from the head of 'slot' (-1: the sink) with the capacity of a slot.
+static void cam_jpeg_rearm(int32_t slot)
+{
+    // abort() may raise a spurious completion IRQ
+    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH0, false);
+    dma_channel_abort(DMA_CAM_RD_CH0);
+    dma_channel_acknowledge_irq0(DMA_CAM_RD_CH0);
+    dma_channel_set_irq0_enabled(DMA_CAM_RD_CH0, true);
+    dma_channel_set_trans_count(DMA_CAM_RD_CH0, cam_frame_words, false);
+    cam_dma_arm(DMA_CAM_RD_CH0, slot, 0);
+    dma_channel_start(DMA_CAM_RD_CH0);
+}
+
+// JPEG: restart PIO from the frame start and rewind CH0 to the head of its slot.
+// must be called with cam_ring_lock held.
+static void cam_jpeg_restart(void)
+{
+    pio_sm_set_enabled(pio_cam, sm_cam, false);
+    pio_sm_clear_fifos(pio_cam, sm_cam);
+    pio_sm_restart(pio_cam, sm_cam);
+    pio_sm_exec(pio_cam, sm_cam, pio_encode_jmp(offset_cam));
+    pio_interrupt_clear(pio_cam, 0);
+    cam_jpeg_rearm(dma_slot[0]);
+    pio_sm_set_enabled(pio_cam, sm_cam, true);
+}
+
+// JPEG: PIO pushed the last words of a frame (partial word and byte count).
+// the frame is finalized by cam_acquire_frame(), so only the DMA position is taken here.
+void cam_jpeg_handler()
+{
+    uint32_t now = time_us_32();
+    pio_interrupt_clear(pio_cam, 0);
+
+    // wait until DMA takes the trailer from RX FIFO (PIO does not push again before the next HREF)
+    while (!pio_sm_is_rx_fifo_empty(pio_cam, sm_cam))
+        tight_loop_contents();
+    uint32_t remain;
+    do
+    {
+        remain = dma_channel_hw_addr(DMA_CAM_RD_CH0)->transfer_count;
+        busy_wait_at_least_cycles(32);
+    } while (remain != dma_channel_hw_addr(DMA_CAM_RD_CH0)->transfer_count);
 
-    if (triggered_dma & (1u << DMA_CAM_RD_CH1))
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    cam_ring_complete(dma_slot[0], now);
+    if (dma_slot[0] >= 0)
     {
-        // Triggered by DMA_CAM_RD_CH1
-        // printf("DMA channel 1 triggered the interrupt.\n");
-        dma_chan = DMA_CAM_RD_CH1;
-        psram_access = 1;
-        b = cam_ptr1;
-        // gpio_put(25, 0);
+        cam_ring[dma_slot[0]].words = cam_frame_words - remain;
+        cam_ring[dma_slot[0]].length = 0;
     }
+    dma_slot[0] = cam_ring_arm_next();
+
+    // CH0 is still waiting for the rest of the slot: rewind it to the next slot
+    cam_jpeg_rearm(dma_slot[0]);
+    spin_unlock(cam_ring_lock, save);
+
+    BaseType_t woken = pdFALSE;
+    cam_frame_notify(&woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void cam_handler()
+{
+    uint32_t triggered_dma = dma_hw->ints0; // DMA_IRQ_0に関連する割り込みステータス
+    uint32_t now = time_us_32();
+    cam_strip_t strips[2];
+    uint32_t n_strips = 0;
+    bool frame_done = false;
+    BaseType_t woken = pdFALSE;
 
     // clear interrupt flag
-    dma_hw->ints0 = triggered_dma;
+    dma_hw->ints0 = triggered_dma & ((1u << DMA_CAM_RD_CH0) | (1u << DMA_CAM_RD_CH1));
+
+    uint32_t save = spin_lock_blocking(cam_ring_lock);
+    for (int32_t ch = 0; ch < 2; ch++)
+    {
+        uint32_t dma_chan = (ch == 0) ? DMA_CAM_RD_CH0 : DMA_CAM_RD_CH1;
+        if (!(triggered_dma & (1u << dma_chan)))
+            continue;
+
+        if (cam_capture_mode == CAM_CAPTURE_JPEG)
+        {
+            // JPEG frame is larger than a slot: drop it and wait for the next VSYNC
+            frames_dropped++;
+            cam_jpeg_restart();
+            continue;
+        }
+        if (cam_strips > 1)
+        {
+            frame_done |= cam_strip_done(ch, dma_chan, now, &strips[n_strips]);
+            if (strips[n_strips].slot >= 0)
+                n_strips++;
+            continue;
+        }
+        if (cam_pad_enabled)
+        {
+            // CH0 hit the end of the line list
+            cam_ring_complete(dma_slot[0], now);
+            frame_done = true;
+            dma_slot[0] = cam_ring_arm_next();
+
+            // restart the control channel with the line list of the next slot
+            cam_dma_arm(DMA_CAM_RD_CH0, dma_slot[0], 0);
+            dma_channel_set_read_addr(DMA_CAM_RD_CH1, cam_pad_line_list(dma_slot[0]), true);
+            continue;
+        }
+
+        // publish the completed slot (or drop the frame of the sink)
+        cam_ring_complete(dma_slot[ch], now);
+        frame_done = true;
+
+        // the completed slot itself is a candidate(newest, so picked last), unless it was the sink
+        dma_slot[ch] = cam_ring_arm_next();
+
+        // reset the DMA initial write address
+        cam_dma_arm(dma_chan, dma_slot[ch], 0);
+    }
+    spin_unlock(cam_ring_lock, save);
 
-    // reset the DMA initial write address
-    dma_channel_set_write_addr(dma_chan, b, false);
+    // wake the tasks waiting for a frame
+    cam_frame_notify(&woken);
 
-    num_of_call_this = 0;
-    return;
+    // hand strips to the consumer
+    for (uint32_t i = 0; i < n_strips; i++)
+    {
+        if (xQueueSendFromISR(cam_strip_queue, &strips[i], &woken) != pdTRUE)
+        {
+            save = spin_lock_blocking(cam_ring_lock);
+            cam_ring[strips[i].slot].readers--;
+            spin_unlock(cam_ring_lock, save);
+            strips_dropped++;
+        }
+    }
+
+    // ROI: all commands of this frame are already consumed by PIO. feed the next frame.
+    if (cam_line_cmd && frame_done)
+    {
+        dma_channel_set_read_addr(DMA_CAM_CMD_CH, cam_roi_cmd, true);
+    }
+    portYIELD_FROM_ISR(woken);
 }
 
 //// PWM
@@ -503,9 +2192,21 @@ void vImageProc(void *pvParameters)
 {
     printf("vImageProc - Running on Core: %d\n", get_core_num()); // 現在のコア番号を表示
 
+#if (USE_COLOR_IMAGE)
+    vTaskDelete(NULL); // 深度推定なし (フレームは rj45_cam() がそのまま送る)
+#endif
+    while (1)
+    {
+        calc_image(); // 勾配バッファとフレームが揃うまでブロック
+    }
+}
+
+void vDepthProc(void *pvParameters)
+{
+    printf("vDepthProc - Running on Core: %d\n", get_core_num()); // 現在のコア番号を表示
+
     while (1)
     {
-        calc_image();
-        vTaskDelay(pdMS_TO_TICKS(1));
+        calc_depth(); // A から勾配が来るまでブロック
     }
 }
\ No newline at end of file
@@ -9,8 +9,24 @@
 #include "timers.h"
 #include "semphr.h"
 #include "pico/async_context_freertos.h"
+#include "depth_solver.h"
 
 #define USE_100BASE_FX (false)
+#define USE_COLOR_IMAGE (0) // 0: Depth Estimate, 1:RGB565
+#define USE_JPEG_IMAGE (0)  // 1: JPEG instead of RGB565 (USE_COLOR_IMAGE=1, OV5642 only)
+#define USE_FC_PACKED (1)   // 1: fcmethod_packed() (p + i*q in one complex FFT), 0: fcmethod()
+#define USE_FC_HALF (0)     // 1: depth map in 16-bit float (arithmetic/half.h), with USE_FC_PACKED
+#define USE_FC_FIXED (0)    // 1: fcmethod_fixed() (Q31 FFT, Q15 depth map). overrides USE_FC_PACKED
+#define USE_FUSED_FRONT (1) // 1: RGB565 green extraction + padding + light source in one pass (arithmetic/fused_front.h)
+                            // RGB565 capture only. main.c captures CAM_CAPTURE_GREEN with pad capture (DMA writes the padded
+                            // green image), so the shipped configuration does not use it.
+#define USE_FIXED_LIGHT (0) // 1: no light-source estimation. normals from the fixed L with the lookup table (arithmetic/normal_lut.h)
+#define LIGHT_DECIMATE (4)  // light source from a 1/4 (or 1/8) image. 1: full resolution (estimate_lightsource_and_normal())
+#define LIGHT_INTERVAL (30) // re-estimate the light source every N frames ...
+#define LIGHT_DRIFT (8.0f)  // ... or when the mean intensity (0..255) moves more than this
+#define LIGHT_MEAN_STEP (8) // mean intensity from every 8th pixel (in x and y)
+#define DEPTH_SOLVER_DEFAULT (DEPTH_SOLVER_FC) // depth solver at boot (arithmetic/depth_solver.h). see cam_set_depth_solver()
+#define DEPTH_SOLVER_BENCH (0)                 // 1: print time and memory of the depth solvers (128, 256, 512) at boot
 
 #define SYS_CLK_IN_KHZ (260000) // 192000 ~ 250000 (if you use sfp, SYS_CLK_KHZ must be just 250000)
 #define CAM_BASE_PIN (1)        // GP1 (camera module needs 11pin)
@@ -18,6 +34,9 @@
 #define LINEAR_BURST (512)      // IoT SRAM's burst length(in bytes)
 #define SFP_HEADER_WORDS (4)    // header length(in words, = sizeof(uint32))
 
+#define CAM_STARTUP_FRAMES (3)        // frames to wait after the register profile (instead of a fixed sleep)
+#define CAM_STARTUP_TIMEOUT_MS (1000) // give up waiting for the stream
+
 // interfaces
 // SCCB IF
 #define I2C1_SDA (26)
@@ -25,20 +44,106 @@
 
 // camera buffer size
 // 640x480, RGB565 picture needs 640x480x2 bytes of buffers.
+// PAD_W x PAD_H may be a native sensor size (640x480, 320x240, ...): fcmethod_packed() uses the mixed-radix
+// FFT (arithmetic/fft_mixed.h) for sizes of 2^a 3^b 5^c, so there is no need to pad up to 1024x512.
 #define IMG_H (256)                                  //(480)
 #define IMG_W (256)                                  //(640)
-#define PAD_H (256)                                  //(512) // in bytes
-#define PAD_W (256)                                  //(512)
+#define PAD_H (256)                                  //(480) // in bytes
+#define PAD_W (256)                                  //(640)
 #define CAM_FUL_SIZE (IMG_W * IMG_H)                 // VGA size, RGB565(16bit) format
 #define CAM_TOTAL_LEN (CAM_FUL_SIZE * 2)             // total length of pictures
 #define CAM_TOTAL_FRM (CAM_TOTAL_LEN / CAM_FUL_SIZE) // numbers(or frames) of pictures
 #define CAM_PADDED_SIZE_IN_32 (PAD_W * PAD_H / 2)    // in uint32_t[] size
+#define CAM_PAD_BORDER (10)                          // zero border for normal estimation (in pixels)
+
+// sensor mode (see 'cam_set_mode()'). IMG_W x IMG_H is the mode after init_cam().
+#define CAM_MODE_MAX_W (640)
+#define CAM_MODE_MAX_H (480)
+#define CAM_MODE_DRAIN_TIMEOUT_MS (500) // wait for consumers to release frames of the old mode
+
+// capture mode (see 'picampinos.pio')
+#define CAM_CAPTURE_RGB565 (0) // RGB565: 2 pixels per word
+#define CAM_CAPTURE_GREEN (1)  // green of RGB565 only: 4 pixels per word (G << 2)
+#define CAM_CAPTURE_Y8 (2)     // Y of YUV422 only: 4 pixels per word
+#define CAM_CAPTURE_JPEG (3)   // OV5642 JPEG: 4 bytes per word, variable length
+
+// ROI / decimation (see 'cam_set_roi()')
+#define CAM_ROI_MAX_PIXELS (1023) // 10bit fields of the PIO line command
+#define CAM_ROI_MAX_SKIP_LINES (255)
+#define CAM_ROI_CMD_MAX (CAM_MODE_MAX_H + 1) // line commands per frame (+1 for a long first_line)
+
+// frame ring
+// two slots are always armed for the ping-pong DMA, the rest hold finished frames for consumers.
+#define CAM_RING_SLOTS (4) // number of frame slots in PSRAM (>= 3)
+
+typedef struct
+{
+    uint32_t *buf;         // frame data (RGB565 x2 or 8bit x4 packed in uint32_t)
+    uint16_t width;        // pixels per line (IMG_W, or ROI width / skip)
+    uint16_t height;       // lines per frame (IMG_H, or ROI height / skip)
+    uint32_t length;       // valid bytes in buf (JPEG: compressed size, 0 if the frame is broken)
+    uint32_t seq;          // frame sequence number (starts from 1, 0 means 'no frame')
+    uint32_t timestamp_us; // time_us_32() when DMA completed the frame
+    int32_t slot;          // slot index in the ring (used by cam_release_frame())
+} cam_frame_t;
+
+// row strips
+// in strip mode, DMA completes every 'rows' lines and each strip is queued for consumers
+// while the rest of the frame is still arriving.
+#define CAM_STRIP_QUEUE_LEN (8)
+
+typedef struct
+{
+    uint32_t *buf;      // 1st line of the strip (in the frame slot)
+    uint32_t seq;       // sequence number of the frame
+    uint16_t width;     // pixels per line
+    uint16_t height;    // lines per frame
+    uint16_t first_row; // line number of buf
+    uint16_t rows;      // lines in the strip
+    bool last;          // last strip of the frame
+    int32_t slot;       // slot index in the ring (used by cam_release_strip())
+} cam_strip_t;
+
+// depth pipeline
+// A: frame -> padded image -> normals (p, q)   'vImageProc()' (calc_image())
+// B: p, q -> depth map                          'vDepthProc()' (calc_depth())
+// C: depth map -> UDP                           'rj45_cam()'
+// A and B pass p, q buffers through bounded queues of buffer handles (A blocks until B returns one).
+// B publishes depth maps to C through a triple buffer: B writes one, swaps it with the last completed
+// one, and C swaps that with the one it has sent. neither side ever waits for the other, and C always
+// sends the newest depth map (maps replaced before C got to them are counted in 'dropped').
+// A works on frame n+1 while B solves frame n and C sends frame n-1. the tasks are pinned to cores in main().
+// the FFT helper of B shares A's core at a higher priority (FFT_TASK_PRIORITY): A is stopped while it runs, see 'helper_us'.
+#define CAM_PIPE_GRAD_BUFS (2) // p, q buffers between A and B (1: A and B do not overlap. USE_FC_FIXED: always 1)
+
+enum
+{
+    CAM_STAGE_NORMAL = 0, // A
+    CAM_STAGE_DEPTH,      // B
+    CAM_STAGE_SEND,       // C
+    CAM_STAGES
+};
+
+typedef struct
+{
+    uint32_t frames;  // frames finished by the stage
+    uint32_t busy_us; // time spent on them (occupancy = busy_us / elapsed)
+    uint32_t wait_us; // time blocked for a buffer of the previous (input) or next (output) stage
+    uint32_t queued;  // buffers ready for the stage (A: free p, q buffers, B: p, q to solve, C: depth map to send)
+    uint32_t dropped; // C: depth maps replaced by a newer one before they were sent
+    uint32_t helper_us;      // B: time the FFT helper of rdft2d_dual() ran B's second half on A's core
+                             // A: helper passes that started with A ready: A was stopped for all of them
+    uint32_t helper_woke_us; // A: helper passes during which A woke up: A was stopped for part of them
+                             // (A lost between helper_us and helper_us + helper_woke_us, counted in its busy_us
+                             // or wait_us. see 'fft_helper_get_stats()')
+} cam_stage_stats_t;
 
 // FreeRTOS Tasks
 void vImageProc(void *pvParameters);
+void vDepthProc(void *pvParameters);
 
 // high layer APIs
-void init_cam(uint8_t DEVICE_IS);
+void init_cam(uint8_t DEVICE_IS, uint8_t capture_mode);
 void config_cam_buffer();
 void start_cam();
 void uartout_cam();
@@ -46,4 +151,69 @@ void sfp_cam();
 void rj45_cam();
 void free_cam();
 void calc_image();
+void calc_depth();
+
+// frame ring APIs
+// cam_acquire_frame() returns the newest complete frame newer than 'last_seq'.
+// the slot is never overwritten by DMA until cam_release_frame() is called.
+bool cam_acquire_frame(cam_frame_t *frm, uint32_t last_seq);
+void cam_release_frame(cam_frame_t *frm);
+void cam_get_frame_stats(uint32_t *captured, uint32_t *dropped);
+
+// frame events
+// cam_handler() (DMA IRQ) notifies the tasks blocked in cam_wait_frame() with the slot and the sequence
+// number of the frame it has just published, so consumers sleep until there is a new frame.
+#define CAM_FRAME_NOTIFY_INDEX (1) // task notification index (configTASK_NOTIFICATION_ARRAY_ENTRIES >= 2)
+#define CAM_FRAME_WAITERS (4)      // tasks that can use cam_wait_frame() (others fall back to cam_acquire_frame())
+#define CAM_FRAME_WAIT_MS (100)    // calc_image() returns after this without a frame (camera stopped)
+
+// cam_acquire_frame() that blocks until a frame newer than 'last_seq' is complete (FreeRTOS tasks only).
+// returns false on timeout.
+bool cam_wait_frame(cam_frame_t *frm, uint32_t last_seq, TickType_t timeout);
+
+// JPEG (CAM_CAPTURE_JPEG)
+// a frame is stored in a slot of RGB565 size. frames larger than that are dropped.
+// ROI, pad capture and row strips are not available.
+
+// sensor mode APIs
+// change the sensor output size (width: multiple of 4), capture mode and frame rate(1 / frame_div)
+// while streaming. ROI is cleared. frame buffers are reallocated only when the new frame is larger.
+// returns false if the mode is not acceptable (depth estimation needs power of 2 and <= PAD_W x PAD_H)
+// or frames of the old mode are not released in CAM_MODE_DRAIN_TIMEOUT_MS.
+bool cam_set_mode(uint32_t width, uint32_t height, uint8_t capture_mode, uint8_t frame_div);
+
+// ROI APIs
+// capture lines [first_line, first_line + line_count) and pixels [first_pixel, first_pixel + pixel_count)
+// of the sensor image, every 'skip'(1,2,4) lines and pixels. can be called while streaming.
+// returns false if the ROI is not acceptable. (frame width must be multiple of 4,
+// and power of 2 for depth estimation)
+bool cam_set_roi(uint32_t first_line, uint32_t line_count, uint32_t first_pixel, uint32_t pixel_count, uint8_t skip);
+void cam_clear_roi();
+void cam_get_frame_size(uint32_t *width, uint32_t *height);
+
+// pad capture APIs
+// DMA writes the inside of CAM_PAD_BORDER directly into the padded layout, so frames can be
+// passed to estimate_lightsource_and_normal() without zeroPadImageWithBorder().
+// 8bit capture modes only (CAM_CAPTURE_GREEN, CAM_CAPTURE_Y8). row strips are disabled.
+bool cam_set_pad_capture(bool enable);
+
+// depth solver APIs
+// DEPTH_SOLVER_FC, DEPTH_SOLVER_DCT, DEPTH_SOLVER_MG. DCT and MG have Neumann boundaries, so the software
+// padding (CAM_PAD_BORDER) is skipped for them (the pad capture layout of the DMA keeps its border).
+// float depth map only (USE_FC_PACKED without USE_FC_HALF, USE_FC_FIXED): other builds accept DEPTH_SOLVER_FC only.
+bool cam_set_depth_solver(int id);
+int cam_get_depth_solver(void);
+
+// pipeline APIs
+// counters since boot or the last cam_reset_pipe_stats(). elapsed_us: time since then
+void cam_get_pipe_stats(cam_stage_stats_t st[CAM_STAGES], uint32_t *elapsed_us);
+void cam_reset_pipe_stats(void);
+
+// strip APIs
+// cam_set_strip_rows(0) goes back to frame mode. 'rows' must divide the frame height into 2 or more strips.
+// every strip holds its frame slot (DMA does not reuse it) until cam_release_strip(); release it without delay.
+bool cam_set_strip_rows(uint32_t rows);
+bool cam_wait_strip(cam_strip_t *strip, TickType_t timeout);
+void cam_release_strip(cam_strip_t *strip);
+void cam_get_strip_stats(uint32_t *dropped);
 void set_pwm_freq_kHz(uint32_t freq_khz, uint32_t system_clk_khz, uint8_t gpio_num);
@@ -44,6 +44,7 @@
 TaskHandle_t rj45Handle;
 TaskHandle_t rxHandle;
 TaskHandle_t imageHandle;
+TaskHandle_t depthHandle;
 
 void vRJ45Task(void *pvParameters);
 // FreeRTOS Tasks: End
@@ -140,7 +141,11 @@ int main()
     // read_i2c_data(i2c);
 #endif
 
-    init_cam(DEV_OV5642);
+    // depth estimation needs green only
+    init_cam(DEV_OV5642, USE_COLOR_IMAGE ? (USE_JPEG_IMAGE ? CAM_CAPTURE_JPEG : CAM_CAPTURE_RGB565) : CAM_CAPTURE_GREEN);
+#if !(USE_COLOR_IMAGE)
+    cam_set_pad_capture(true); // DMA writes frames in the padded layout (no zeroPadImageWithBorder())
+#endif
     config_cam_buffer(); // config buffer
     start_cam();         // start streaming
     printf("[CAM INIT]\n");
@@ -152,17 +157,27 @@ int main()
     xTaskCreate(vRJ45Task, "Eth Task", configMINIMAL_STACK_SIZE * 5, NULL, tskIDLE_PRIORITY + 2, &rj45Handle);
     xTaskCreate(vLaunchRxFunc, "Rx Task", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 2, &rxHandle);
     xTaskCreate(vImageProc, "Image Task", configMINIMAL_STACK_SIZE * 5, NULL, tskIDLE_PRIORITY + 2, &imageHandle);
-    xTaskCreate(vProcessingFFTTask, "ProcessingTask", configMINIMAL_STACK_SIZE * 1, NULL, tskIDLE_PRIORITY + 2, &FFTTaskHandle);
+#if !(USE_COLOR_IMAGE)
+    xTaskCreate(vDepthProc, "Depth Task", configMINIMAL_STACK_SIZE * 5, NULL, tskIDLE_PRIORITY + 2, &depthHandle);
+#endif
+    xTaskCreate(vProcessingFFTTask, "ProcessingTask", FFT_TASK_STACK_SIZE, NULL, FFT_TASK_PRIORITY, &FFTTaskHandle);
     // xTaskCreate(rftfcol_task, "Rftfcol_Task_1", 2048, NULL, 1, &rftfcol_task_handle);
 
+    // depth pipeline (see 'cam.h'): A = Image Task (normals), B = Depth Task (FFT), C = Eth Task (send)
+    // B runs on the other core than A, and the FFT helper of rdft2d_dual() on the other core than B.
+    // the helper shares core 1 with A and Rx above their priority, so B's second half preempts them
+    // instead of time-slicing with them (the time A lost to it is in the stage stats, 'helper_us')
     // xMutexInit();
     uxCoreAffinityMask = ((1 << 0)); // Core0
     vTaskCoreAffinitySet(rj45Handle, uxCoreAffinityMask);
-    vTaskCoreAffinitySet(FFTTaskHandle, uxCoreAffinityMask);
+#if !(USE_COLOR_IMAGE)
+    vTaskCoreAffinitySet(depthHandle, uxCoreAffinityMask);
+#endif
 
     uxCoreAffinityMask = ((1 << 1)); // Core1
     vTaskCoreAffinitySet(rxHandle, uxCoreAffinityMask);
     vTaskCoreAffinitySet(imageHandle, uxCoreAffinityMask);
+    vTaskCoreAffinitySet(FFTTaskHandle, uxCoreAffinityMask);
 
     //   FreeRTOSのスケジューラを開始
     vTaskStartScheduler();
@@ -2,22 +2,826 @@
 #include "pico/stdlib.h"
 #include "sccb_if.h"
 
+/*******************************************************************************
+ * Register Profiles
+ * {register, value, delay(ms) after the write}
+ * OV2640: 8bit register address (0xff selects the register bank)
+ * OV5642: 16bit register address
+ */
+
+static const sccb_reg_t ov2640_init_regs[] = {
+    {0xff, 0x00, 0}, // Device control register list Table 12
+    {0x2c, 0xff, 0}, // Reserved
+    {0x2e, 0xdf, 0}, // Reserved
+    {0xff, 0x01, 0}, // Device control register list Table 13
+    {0x3c, 0x32, 0}, // Reserved
+    {0x11, 0x00, 0}, // Clock Rate Control
+    {0x09, 0x02, 0}, // Common control 2
+    {0x04, 0x28, 0}, // Mirror
+    {0x13, 0xe5, 0}, // Common control 8
+    {0x14, 0x48, 0}, // Common control 9
+    {0x2c, 0x0c, 0}, // Reserved
+    {0x33, 0x78, 0}, // Reserved
+    {0x3a, 0x33, 0}, // Reserved
+    {0x3b, 0xfb, 0}, // Reserved
+    {0x3e, 0x00, 0}, // Reserved
+    {0x43, 0x11, 0}, // Reserved
+    {0x16, 0x10, 0}, // Reserved
+    {0x4a, 0x81, 0}, // Reserved
+    {0x21, 0x99, 0}, // Reserved
+    {0x24, 0x40, 0}, // Luminance signal High range
+    {0x25, 0x38, 0}, // Luminance signal low range
+    {0x26, 0x82, 0},
+    {0x5c, 0x00, 0}, // Reserved
+    {0x63, 0x00, 0}, // Reserved
+    {0x46, 0x3f, 0}, // Frame length adjustment
+    {0x0c, 0x3c, 0}, // Common control 3
+    {0x61, 0x70, 0}, // Histogram algo low level
+    {0x62, 0x80, 0}, // Histogram algo high level
+    {0x7c, 0x05, 0}, // Reserved
+    {0x20, 0x80, 0}, // Reserved
+    {0x28, 0x30, 0}, // Reserved
+    {0x6c, 0x00, 0}, // Reserved
+    {0x6d, 0x80, 0}, // Reserved
+    {0x6e, 0x00, 0}, // Reserved
+    {0x70, 0x02, 0}, // Reserved
+    {0x71, 0x94, 0}, // Reserved
+    {0x73, 0xc1, 0}, // Reserved
+    {0x3d, 0x34, 0}, // Reserved
+    {0x5a, 0x57, 0}, // Reserved
+    {0x12, 0x00, 0}, // Common control 7
+    {0x11, 0x00, 0}, // Clock Rate Control                   2
+    {0x17, 0x11, 0}, // Horiz window start MSB 8bits
+    {0x18, 0x75, 0}, // Horiz window end MSB 8bits
+    {0x19, 0x01, 0}, // Vert window line start MSB 8bits
+    {0x1a, 0x97, 0}, // Vert window line end MSB 8bits
+    {0x32, 0x36, 0},
+    {0x03, 0x0f, 0},
+    {0x37, 0x40, 0},
+    {0x4f, 0xbb, 0},
+    {0x50, 0x9c, 0},
+    {0x5a, 0x57, 0},
+    {0x6d, 0x80, 0},
+    {0x6d, 0x38, 0},
+    {0x39, 0x02, 0},
+    {0x35, 0x88, 0},
+    {0x22, 0x0a, 0},
+    {0x37, 0x40, 0},
+    {0x23, 0x00, 0},
+    {0x34, 0xa0, 0},
+    {0x36, 0x1a, 0},
+    {0x06, 0x02, 0},
+    {0x07, 0xc0, 0},
+    {0x0d, 0xb7, 0},
+    {0x0e, 0x01, 0},
+    {0x4c, 0x00, 0},
+    {0xff, 0x00, 0},
+    {0xe5, 0x7f, 0},
+    {0xf9, 0xc0, 0},
+    {0x41, 0x24, 0},
+    {0xe0, 0x14, 0},
+    {0x76, 0xff, 0},
+    {0x33, 0xa0, 0},
+    {0x42, 0x20, 0},
+    {0x43, 0x18, 0},
+    {0x4c, 0x00, 0},
+    {0x87, 0xd0, 0},
+    {0x88, 0x3f, 0},
+    {0xd7, 0x03, 0},
+    {0xd9, 0x10, 0},
+    {0xd3, 0x82, 0},
+    {0xc8, 0x08, 0},
+    {0xc9, 0x80, 0},
+    {0x7d, 0x00, 0},
+    {0x7c, 0x03, 0},
+    {0x7d, 0x48, 0},
+    {0x7c, 0x08, 0},
+    {0x7d, 0x20, 0},
+    {0x7d, 0x10, 0},
+    {0x7d, 0x0e, 0},
+    {0x90, 0x00, 0},
+    {0x91, 0x0e, 0},
+    {0x91, 0x1a, 0},
+    {0x91, 0x31, 0},
+    {0x91, 0x5a, 0},
+    {0x91, 0x69, 0},
+    {0x91, 0x75, 0},
+    {0x91, 0x7e, 0},
+    {0x91, 0x88, 0},
+    {0x91, 0x8f, 0},
+    {0x91, 0x96, 0},
+    {0x91, 0xa3, 0},
+    {0x91, 0xaf, 0},
+    {0x91, 0xc4, 0},
+    {0x91, 0xd7, 0},
+    {0x91, 0xe8, 0},
+    {0x91, 0x20, 0},
+    {0x92, 0x00, 0},
+    {0x93, 0x06, 0},
+    {0x93, 0xe3, 0},
+    {0x93, 0x02, 0},
+    {0x93, 0x02, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x04, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x03, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x00, 0},
+    {0x93, 0x00, 0},
+    {0x96, 0x00, 0},
+    {0x97, 0x08, 0},
+    {0x97, 0x19, 0},
+    {0x97, 0x02, 0},
+    {0x97, 0x0c, 0},
+    {0x97, 0x24, 0},
+    {0x97, 0x30, 0},
+    {0x97, 0x28, 0},
+    {0x97, 0x26, 0},
+    {0x97, 0x02, 0},
+    {0x97, 0x98, 0},
+    {0x97, 0x80, 0},
+    {0x97, 0x00, 0},
+    {0x97, 0x00, 0},
+    {0xc3, 0xef, 0},
+    {0xff, 0x00, 0},
+    {0xba, 0xdc, 0},
+    {0xbb, 0x08, 0},
+    {0xb6, 0x24, 0},
+    {0xb8, 0x33, 0},
+    {0xb7, 0x20, 0},
+    {0xb9, 0x30, 0},
+    {0xb3, 0xb4, 0},
+    {0xb4, 0xca, 0},
+    {0xb5, 0x43, 0},
+    {0xb0, 0x5c, 0},
+    {0xb1, 0x4f, 0},
+    {0xb2, 0x06, 0},
+    {0xc7, 0x00, 0},
+    {0xc6, 0x51, 0},
+    {0xc5, 0x11, 0},
+    {0xc4, 0x9c, 0},
+    {0xbf, 0x00, 0},
+    {0xbc, 0x64, 0},
+    {0xa6, 0x00, 0},
+    {0xa7, 0x1e, 0},
+    {0xa7, 0x6b, 0},
+    {0xa7, 0x47, 0},
+    {0xa7, 0x33, 0},
+    {0xa7, 0x00, 0},
+    {0xa7, 0x23, 0},
+    {0xa7, 0x2e, 0},
+    {0xa7, 0x85, 0},
+    {0xa7, 0x42, 0},
+    {0xa7, 0x33, 0},
+    {0xa7, 0x00, 0},
+    {0xa7, 0x23, 0},
+    {0xa7, 0x1b, 0},
+    {0xa7, 0x74, 0},
+    {0xa7, 0x42, 0},
+    {0xa7, 0x33, 0},
+    {0xa7, 0x00, 0},
+    {0xa7, 0x23, 0},
+    {0xc0, 0xc8, 0},
+    {0xc1, 0x96, 0},
+    {0x8c, 0x00, 0},
+    {0x86, 0x3d, 0},
+    {0x50, 0x92, 0},
+    {0x51, 0x90, 0},
+    {0x52, 0x2c, 0},
+    {0x53, 0x00, 0},
+    {0x54, 0x00, 0},
+    {0x55, 0x88, 0},
+    {0x5a, 0x50, 0},
+    {0x5b, 0x3c, 0},
+    {0x5c, 0x00, 0},
+    {0xd3, 0x04, 0},
+    {0x7f, 0x00, 0},
+    {0xda, 0x00, 0},
+    {0xe5, 0x1f, 0},
+    {0xe1, 0x67, 0},
+    {0xe0, 0x00, 0},
+    {0xdd, 0x7f, 0},
+    {0x05, 0x00, 0},
+    {0xff, 0x00, 0},
+    {0xe0, 0x04, 0},
+    {0xc0, 0xc8, 0},
+    {0xc1, 0x96, 0},
+    {0x86, 0x3d, 0},
+    {0x50, 0x92, 0},
+    {0x51, 0x90, 0},
+    {0x52, 0x2c, 0},
+    {0x53, 0x00, 0},
+    {0x54, 0x00, 0},
+    {0x55, 0x88, 0},
+    {0x57, 0x00, 0},
+    {0x5a, 0x50, 0},
+    {0x5b, 0x3c, 0},
+    {0x5c, 0x00, 0},
+    {0xd3, 0x04, 0},
+    {0xe0, 0x00, 0},
+    {0xff, 0x00, 0},
+    {0x05, 0x00, 0},
+    {0xda, 0x08, 0},
+    {0xda, 0x08, 0},
+    {0x98, 0x00, 0},
+    {0x99, 0x00, 0},
+    {0x00, 0x00, 0},
+    {0xff, 0x00, 0},
+    {0xe0, 0x04, 0},
+    {0xc0, 0xc8, 0},
+    {0xc1, 0x96, 0},
+    {0x86, 0x3d, 0},
+    {0x50, 0x89, 0},
+    {0x51, 0x90, 0},
+    {0x52, 0x2c, 0},
+    {0x53, 0x00, 0},
+    {0x54, 0x00, 0},
+    {0x55, 0x88, 0},
+    {0x57, 0x00, 0},
+    {0x5a, 0xa0, 0},
+    {0x5b, 0x78, 0},
+    {0x5c, 0x00, 0},
+    {0xd3, 0x02, 0},
+    {0xe0, 0x00, 0},
+};
+
+static const sccb_reg_t ov5642_init_regs[] = {
+    // PLL
+    {0x3103, 0x93, 0},
+    // Reset system
+    {0x3008, 0x82, 5}, // reset: wait 5 ms
+    // output enable(1)
+    {0x3017, 0x7f, 0},
+    // output enable(2)
+    {0x3018, 0xfc, 0},
+    // HV offset setting
+    {0x3810, 0xc2, 0},
+    // analog setting
+    {0x3615, 0xf0, 0},
+    // block init
+    {0x3000, 0x00, 0},
+    {0x3001, 0x00, 0},
+    {0x3002, 0x00, 0},
+    {0x3003, 0x00, 0},
+    {0x3000, 0xf8, 0},
+    {0x3001, 0x48, 0},
+    {0x3002, 0x5c, 0},
+    {0x3003, 0x02, 0},
+    // block clock enable
+    {0x3004, 0x07, 0},
+    {0x3005, 0xb7, 0},
+    {0x3006, 0x43, 0},
+    {0x3007, 0x37, 0},
+    // PLL(FPS)
+    // 0x3011=0x08:15fps
+    // 0x3011=0x10:30fps
+    {0x3011, 0x08, 0},
+    {0x3010, 0x10, 0},
+    // VFIFO
+    {0x460c, 0x22, 0},
+    // unknown settings
+    {0x3815, 0x04, 0},
+    // array control
+    {0x370d, 0x06, 0},
+    // analog settings
+    {0x370c, 0xa0, 0},
+    {0x3602, 0xfc, 0},
+    {0x3612, 0xff, 0},
+    {0x3634, 0xc0, 0},
+    {0x3613, 0x00, 0},
+    {0x3605, 0x7c, 0},
+    // array control
+    {0x3621, 0x09, 0},
+    // analog settings
+    {0x3622, 0x00, 0},
+    {0x3604, 0x40, 0},
+    {0x3603, 0xa7, 0},
+    {0x3603, 0x27, 0},
+    // black color level
+    {0x4000, 0x21, 0},
+    {0x401d, 0x02, 0},
+    // analog settings
+    {0x3600, 0x54, 0},
+    {0x3605, 0x04, 0},
+    {0x3606, 0x3f, 0},
+    // flicker
+    {0x3c01, 0x80, 0},
+    // ISP
+    {0x5000, 0x4f, 0},
+    // unknown
+    {0x5020, 0x04, 0},
+    // AWB
+    {0x5181, 0x79, 0},
+    {0x5182, 0x00, 0},
+    {0x5185, 0x22, 0},
+    {0x5197, 0x01, 0},
+    // ISP
+    {0x5001, 0xff, 0},
+    // UV adjust
+    {0x5500, 0x0a, 0},
+    {0x5504, 0x00, 0},
+    {0x5505, 0x7f, 0},
+    // ISP
+    {0x5080, 0x08, 0},
+    // MIPI
+    {0x300e, 0x18, 0},
+    // unknown
+    {0x4610, 0x00, 0},
+    // DVP output
+    {0x471d, 0x05, 0},
+    {0x4708, 0x06, 0},
+    // analog setting register
+    {0x3710, 0x10, 0},
+    {0x3632, 0x41, 0},
+    {0x3702, 0x40, 0},
+    {0x3620, 0x37, 0},
+    {0x3631, 0x01, 0},
+    // output setting
+    {0x3808, 0x01, 0},
+    {0x3809, 0x00, 0}, // 0x80; // H-size:0x0280 = 640, 0x0200 = 512, 0x0100 = 256
+    {0x380a, 0x01, 0},
+    {0x380b, 0x00, 0}, // 0xe0; // V-size:0x01e0 = 480, 0x0200 = 512, 0x0100 = 256
+    {0x380e, 0x07, 0},
+    {0x380f, 0xd0, 0}, // V-pixel:0x07d0 = 2000
+    // select output format
+    {0x501f, 0x00, 0},
+    // ISP Settings
+    {0x5000, 0x4f, 0},
+    // output format settings
+    {0x511e, 0x2a, 0},
+    {0x5002, 0xf8, 0},
+    {0x501f, 0x01, 0},
+    {0x4300, 0x61, 0}, // 0x61=RGB565, 0xF9=YUV422(=Y8,U4,V4)
+    // AEC Settings
+    {0x3503, 0x07, 0}, // VTS Manual
+    {0x3501, 0x73, 0}, // shutter speed
+    {0x3502, 0x80, 0}, // shutter speed
+    {0x350b, 0x00, 0}, // AGC Gain
+    {0x3503, 0x07, 0}, // VTS manual
+    // unknown
+    {0x3824, 0x11, 0},
+    // AEC Settings
+    {0x3501, 0x1e, 0},
+    {0x3502, 0x80, 0},
+    // AGC Settings
+    {0x350b, 0x7f, 0},
+    // output timing settings
+    {0x380c, 0x0c, 0},
+    {0x380d, 0x80, 0},
+    {0x380e, 0x03, 0},
+    {0x380f, 0xe8, 0},
+    // flicker-less settings
+    {0x3a0d, 0x04, 0}, // 60Hz
+    {0x3a0e, 0x03, 0}, // 50Hz
+    // timing and mirror and flip settings
+    // ov5642 default position (0 degrees)
+    // 0x3818 = 0xC1;
+    // 0x3621 = 0xC7;
+    // or if you use ov5642 upside down (turn 180 degrees)
+    // 0x3818 = 0xA1;
+    // 0x3621 = 0xA7;
+    {0x3818, 0xa1, 0},
+    // analog settings register
+    {0x3705, 0xdb, 0},
+    {0x370a, 0x81, 0},
+    // array control
+    {0x3621, 0xa7, 0},
+    // output timing
+    {0x3801, 0x50, 0}, // H-Start:80
+    {0x3803, 0x08, 0}, // V-Start:8
+    // unknown
+    {0x3827, 0x08, 0},
+    // HV offset settings
+    {0x3810, 0xc0, 0},
+    // output timing
+    {0x3804, 0x05, 0},
+    {0x3805, 0x00, 0},
+    // Statistics Settings
+    {0x5682, 0x05, 0},
+    {0x5683, 0x00, 0},
+    // output timing
+    {0x3806, 0x03, 0},
+    {0x3807, 0xc0, 0}, // V-pixel:960
+    // Statistics Settings
+    {0x5686, 0x03, 0},
+    {0x5687, 0xc0, 0}, // V-pixel:960
+    // #102:AEC Settings
+    {0x3a00, 0x78, 0},
+    {0x3a1a, 0x04, 0},
+    {0x3a13, 0x30, 0},
+    {0x3a18, 0x00, 0},
+    {0x3a19, 0x7c, 0},
+    // #107: flicker-less settings
+    {0x3a08, 0x12, 0},
+    {0x3a09, 0xc0, 0},
+    {0x3a0a, 0x0f, 0},
+    {0x3a0b, 0xa0, 0},
+    // #111: block clock enable
+    {0x3004, 0xff, 0},
+    // #112: AEC Settings
+    {0x350c, 0x07, 0},
+    {0x350d, 0xd0, 0},
+    {0x3500, 0x00, 0},
+    {0x3501, 0x00, 0},
+    {0x3502, 0x00, 0},
+    // #117: AGC/AEC Settings
+    {0x350a, 0x00, 0},
+    {0x350b, 0x00, 0},
+    {0x3503, 0x00, 0},
+    // #120: De-Noise Settings
+    {0x528a, 0x02, 0},
+    {0x528b, 0x04, 0},
+    {0x528c, 0x08, 0},
+    {0x528d, 0x08, 0},
+    {0x528e, 0x08, 0},
+    {0x528f, 0x10, 0},
+    {0x5290, 0x10, 0},
+    {0x5292, 0x00, 0},
+    {0x5293, 0x02, 0},
+    {0x5294, 0x00, 0},
+    {0x5295, 0x02, 0},
+    {0x5296, 0x00, 0},
+    {0x5297, 0x02, 0},
+    {0x5298, 0x00, 0},
+    {0x5299, 0x02, 0},
+    {0x529a, 0x00, 0},
+    {0x529b, 0x02, 0},
+    {0x529c, 0x00, 0},
+    {0x529d, 0x02, 0},
+    {0x529e, 0x00, 0},
+    {0x529f, 0x02, 0},
+    // #141: AEC Settings
+    {0x3a0f, 0x3c, 0},
+    {0x3a10, 0x30, 0},
+    {0x3a1b, 0x3c, 0},
+    {0x3a1e, 0x30, 0},
+    {0x3a11, 0x70, 0},
+    {0x3a1f, 0x10, 0},
+    // #147: system settings
+    {0x3030, 0x0b, 0},
+    // #148: AEC Settings
+    {0x3a02, 0x00, 0},
+    {0x3a03, 0x7d, 0},
+    {0x3a04, 0x00, 0},
+    {0x3a14, 0x00, 0},
+    {0x3a15, 0x7d, 0},
+    {0x3a16, 0x00, 0},
+    {0x3a00, 0x7c, 0},
+    // #155: flicker-less settings
+    {0x3a08, 0x09, 0},
+    {0x3a09, 0x60, 0},
+    {0x3a0a, 0x07, 0},
+    {0x3a0b, 0xd0, 0},
+    {0x3a0d, 0x08, 0},
+    {0x3a0e, 0x06, 0},
+    // #161: AWB settings
+    {0x5193, 0x70, 0},
+    // #162: analog settings
+    {0x3620, 0x57, 0},
+    {0x3703, 0x98, 0},
+    {0x3704, 0x1c, 0},
+    // #165: unknown settings
+    {0x589b, 0x04, 0},
+    {0x589a, 0xc5, 0},
+    // #167: De-Noise Settings
+    {0x528a, 0x00, 0},
+    {0x528b, 0x02, 0},
+    {0x528c, 0x08, 0},
+    {0x528d, 0x10, 0},
+    {0x528e, 0x20, 0},
+    {0x528f, 0x28, 0},
+    {0x5290, 0x30, 0},
+    {0x5292, 0x00, 0},
+    {0x5293, 0x00, 0},
+    {0x5294, 0x00, 0},
+    {0x5295, 0x02, 0},
+    {0x5296, 0x00, 0},
+    {0x5297, 0x08, 0},
+    {0x5298, 0x00, 0},
+    {0x5299, 0x10, 0},
+    {0x529a, 0x00, 0},
+    {0x529b, 0x20, 0},
+    {0x529c, 0x00, 0},
+    {0x529d, 0x28, 0},
+    {0x529e, 0x00, 0},
+    {0x529f, 0x30, 0},
+    {0x5282, 0x00, 0},
+    // #189: CIP
+    {0x5300, 0x00, 0},
+    {0x5301, 0x20, 0},
+    {0x5302, 0x00, 0},
+    {0x5303, 0x7c, 0},
+    {0x530c, 0x00, 0},
+    {0x530d, 0x0c, 0},
+    {0x530e, 0x20, 0},
+    {0x530f, 0x80, 0},
+    {0x5310, 0x20, 0},
+    {0x5311, 0x80, 0},
+    {0x5308, 0x20, 0},
+    {0x5309, 0x40, 0},
+    {0x5304, 0x00, 0},
+    {0x5305, 0x30, 0},
+    {0x5306, 0x00, 0},
+    {0x5307, 0x80, 0},
+    {0x5314, 0x08, 0},
+    {0x5315, 0x20, 0},
+    {0x5319, 0x30, 0},
+    {0x5316, 0x10, 0},
+    {0x5317, 0x08, 0},
+    {0x5318, 0x02, 0},
+    // #211: Color Matrix Settings
+    {0x5380, 0x01, 0},
+    {0x5381, 0x00, 0},
+    {0x5382, 0x00, 0},
+    {0x5383, 0x4e, 0},
+    {0x5384, 0x00, 0},
+    {0x5385, 0x0f, 0},
+    {0x5386, 0x00, 0},
+    {0x5387, 0x00, 0},
+    {0x5388, 0x01, 0},
+    {0x5389, 0x15, 0},
+    {0x538a, 0x00, 0},
+    {0x538b, 0x31, 0},
+    {0x538c, 0x00, 0},
+    {0x538d, 0x00, 0},
+    {0x538e, 0x00, 0},
+    {0x538f, 0x0f, 0},
+    {0x5390, 0x00, 0},
+    {0x5391, 0xab, 0},
+    {0x5392, 0x00, 0},
+    {0x5393, 0xa2, 0},
+    {0x5394, 0x08, 0},
+    // #232: Gamma Setings
+    {0x5480, 0x14, 0},
+    {0x5481, 0x21, 0},
+    {0x5482, 0x36, 0},
+    {0x5483, 0x57, 0},
+    {0x5484, 0x65, 0},
+    {0x5485, 0x71, 0},
+    {0x5486, 0x7d, 0},
+    {0x5487, 0x87, 0},
+    {0x5488, 0x91, 0},
+    {0x5489, 0x9a, 0},
+    {0x548a, 0xaa, 0},
+    {0x548b, 0xb8, 0},
+    {0x548c, 0xcd, 0},
+    {0x548d, 0xdd, 0},
+    {0x548e, 0xea, 0},
+    {0x548f, 0x10, 0},
+    {0x5490, 0x05, 0},
+    {0x5491, 0x00, 0},
+    {0x5492, 0x04, 0},
+    {0x5493, 0x20, 0},
+    {0x5494, 0x03, 0},
+    {0x5495, 0x60, 0},
+    {0x5496, 0x02, 0},
+    {0x5497, 0xb8, 0},
+    {0x5498, 0x02, 0},
+    {0x5499, 0x86, 0},
+    {0x549a, 0x02, 0},
+    {0x549b, 0x5b, 0},
+    {0x549c, 0x02, 0},
+    {0x549d, 0x3b, 0},
+    {0x549e, 0x02, 0},
+    {0x549f, 0x1c, 0},
+    {0x54a0, 0x02, 0},
+    {0x54a1, 0x04, 0},
+    {0x54a2, 0x01, 0},
+    {0x54a3, 0xed, 0},
+    {0x54a4, 0x01, 0},
+    {0x54a5, 0xc5, 0},
+    {0x54a6, 0x01, 0},
+    {0x54a7, 0xa5, 0},
+    {0x54a8, 0x01, 0},
+    {0x54a9, 0x6c, 0},
+    {0x54aa, 0x01, 0},
+    {0x54ab, 0x41, 0},
+    {0x54ac, 0x01, 0},
+    {0x54ad, 0x20, 0},
+    {0x54ae, 0x00, 0},
+    {0x54af, 0x16, 0},
+    // #280: AWB Settings
+    {0x3406, 0x00, 0},
+    {0x5192, 0x04, 0},
+    {0x5191, 0xf8, 0},
+    {0x5193, 0xf0, 0}, // R
+    {0x5194, 0x40, 0}, // G
+    {0x5195, 0xf0, 0}, // B
+    {0x518d, 0x3d, 0},
+    {0x518f, 0x54, 0},
+    {0x518e, 0x3d, 0},
+    {0x5190, 0x54, 0},
+    {0x518b, 0xc0, 0},
+    {0x518c, 0xbd, 0},
+    {0x5187, 0x18, 0},
+    {0x5188, 0x18, 0},
+    {0x5189, 0x6e, 0},
+    {0x518a, 0x68, 0},
+    {0x5186, 0x1c, 0},
+    {0x5181, 0x50, 0},
+    // #298: AWB Settings
+    {0x5184, 0x25, 0},
+    {0x5182, 0x11, 0},
+    {0x5183, 0x14, 0},
+    {0x5184, 0x25, 0},
+    {0x5185, 0x24, 0},
+    // ISP Settings
+    {0x5025, 0x82, 0},
+    // #304: AEC Settings
+    {0x3a0f, 0x7e, 0},
+    {0x3a10, 0x72, 0},
+    {0x3a1b, 0x80, 0},
+    {0x3a1e, 0x70, 0},
+    {0x3a11, 0xd0, 0},
+    {0x3a1f, 0x40, 0},
+    // #310: Digital effect
+    {0x5583, 0x40, 0},
+    {0x5584, 0x40, 0},
+    {0x5580, 0x02, 0},
+    // #313: Analog settings register
+    {0x3633, 0x07, 0},
+    {0x3702, 0x10, 0},
+    {0x3703, 0xb2, 0},
+    {0x3704, 0x18, 0},
+    {0x370b, 0x40, 0},
+    // array control
+    {0x370d, 0x02, 0},
+    // #319: analog settings register
+    {0x3620, 0x52, 0},
+#if 1 // pclk=6MHz
+    {0x3011, 0x08, 0},
+    {0x3012, 0x00, 0},
+    {0x3010, 0x70, 0},
+    {0x460c, 0x22, 0},
+    {0x380c, 0x0c, 0},
+    {0x380d, 0x80, 0},
+    {0x3a00, 0x78, 0},
+    {0x3a08, 0x09, 0},
+    {0x3a09, 0x60, 0},
+    {0x3a0a, 0x07, 0},
+    {0x3a0b, 0xd0, 0},
+    {0x3a0d, 0x08, 0},
+    {0x3a0e, 0x06, 0},
+#endif
+    // VSYNC Active-Low & Gate PCLK under VSYNC & HREF
+    {0x4740, 0x2d, 0},
+};
+
+// output format (see 'sccb_set_output_format()')
+static const sccb_reg_t ov2640_rgb565_regs[] = {
+    {0xff, 0x00, 0}, // Device control register list Table 12
+    {0xda, 0x08, 0}, // Image mode: RGB565
+};
+
+static const sccb_reg_t ov2640_yuv422_regs[] = {
+    {0xff, 0x00, 0}, // Device control register list Table 12
+    {0xda, 0x00, 0}, // Image mode: YUV422
+};
+
+// undo 'ov5642_jpeg_regs' (values of 'ov5642_init_regs')
+static const sccb_reg_t ov5642_raw_regs[] = {
+    {0x3818, 0xa1, 0}, // timing control
+    {0x3002, 0x5c, 0}, // block reset
+    {0x3005, 0xb7, 0}, // block clock enable
+    {0x3006, 0x43, 0},
+};
+
+static const sccb_reg_t ov5642_rgb565_regs[] = {
+    {0x501f, 0x01, 0}, // ISP format mux: RGB
+    {0x4300, 0x61, 0}, // output format: RGB565
+};
+
+static const sccb_reg_t ov5642_yuv422_regs[] = {
+    {0x501f, 0x00, 0}, // ISP format mux: YUV
+    {0x4300, 0x30, 0}, // output format: YUYV
+};
+
+// OV5642 JPEG output (compressed from YUV422 inside the sensor)
+// JPEG mode 3: data is valid only while HREF=1 and the line length varies,
+// the frame ends at the next VSYNC (see 'picampinos_jpeg' in picampinos.pio).
+static const sccb_reg_t ov5642_jpeg_regs[] = {
+    {0x4300, 0x18, 0}, // output format: YUV422 (input of the JPEG encoder)
+    {0x501f, 0x00, 0}, // ISP format mux: YUV
+    {0x3818, 0xa8, 0}, // timing control: compression mode (mirror/flip is same as 0xA1)
+    {0x3002, 0x00, 0}, // reset release: JFIFO, SFIFO, JPEG
+    {0x3005, 0xff, 0}, // clock enable: JPEG
+    {0x3006, 0xff, 0},
+    {0x4713, 0x03, 0}, // JPEG mode 3 (variable width, HREF gated)
+    {0x4407, 0x0c, 0}, // quantization scale (smaller is better quality, larger frame)
+    {0x460b, 0x35, 0}, // VFIFO control
+    {0x460c, 0x22, 0}, // PCLK divider controlled by 0x3815 (keep PCLK low enough for the PIO)
+    {0x3815, 0x04, 0}, // PCLK divider
+    {0x4602, 0x01, 0}, // JPEG output width : 0x0100 = 256 (same as the DVP output size)
+    {0x4603, 0x00, 0},
+    {0x4604, 0x01, 0}, // JPEG output height: 0x0100 = 256
+    {0x4605, 0x00, 0},
+};
+
 /*******************************************************************************
  * Function Definitions
  */
-void sccb_init(uint8_t device_is, const uint32_t sda_pin, const uint32_t scl_pin, bool enable_pullup)
+static uint8_t sccb_addr(uint8_t device_is)
 {
+    return (device_is == DEV_OV2640) ? (0x60 >> 1) : (0x78 >> 1);
+}
 
-    uint8_t CAM_ADDR = (0x78 >> 1); // default: OV5642
+// OV5642 has 16bit register address (and auto increment on sequential writes)
+static bool sccb_is_16bit(uint8_t device_is)
+{
+    return (device_is == DEV_OV5642);
+}
 
-    // Ports
+// read 1 register. returns false if the sensor did not answer.
+static bool sccb_read_reg(uint8_t device_is, uint16_t reg, uint8_t *val)
+{
+    i2c_inst_t *i2c = i2c1;
+    uint8_t msg[2];
+    uint8_t len = 0;
+
+    if (sccb_is_16bit(device_is))
+        msg[len++] = reg >> 8;
+    msg[len++] = reg & 0xff;
+    // SCCB does not support repeated start: stop after the address
+    if (i2c_write_blocking(i2c, sccb_addr(device_is), msg, len, false) != len)
+        return false;
+    return (i2c_read_blocking(i2c, sccb_addr(device_is), val, 1, false) == 1);
+}
+
+void sccb_write_profile(uint8_t device_is, const sccb_reg_t *regs, uint32_t num)
+{
     i2c_inst_t *i2c = i2c1;
+    uint8_t msg[2 + SCCB_BURST_MAX];
+    uint32_t i = 0;
+
+    while (i < num)
+    {
+        uint32_t len = 0;
+        uint32_t n = 1;
+
+        if (sccb_is_16bit(device_is))
+        {
+            // coalesce a run of consecutive registers into 1 auto increment write
+            // (a run is cut at a register with delay)
+            while (i + n < num && n < SCCB_BURST_MAX && regs[i + n - 1].delay_ms == 0 &&
+                   regs[i + n].reg == regs[i + n - 1].reg + 1)
+            {
+                n++;
+            }
+            msg[len++] = regs[i].reg >> 8;
+        }
+        msg[len++] = regs[i].reg & 0xff;
+        for (uint32_t j = 0; j < n; j++)
+        {
+            msg[len++] = regs[i + j].val;
+        }
+        reg_write(i2c, sccb_addr(device_is), msg, len);
+
+        if (regs[i + n - 1].delay_ms)
+            sleep_ms(regs[i + n - 1].delay_ms);
+        i += n;
+    }
+}
+
+bool sccb_wait_chip_id(uint8_t device_is, uint32_t timeout_ms)
+{
+    absolute_time_t timeout = make_timeout_time_ms(timeout_ms);
+    uint8_t pid = 0, ver = 0;
+
+    do
+    {
+        if (device_is == DEV_OV2640)
+        {
+            // PIDH/PIDL are in the sensor bank
+            const sccb_reg_t bank1 = {0xff, 0x01, 0};
+            sccb_write_profile(device_is, &bank1, 1);
+            if (sccb_read_reg(device_is, 0x0a, &pid) && sccb_read_reg(device_is, 0x0b, &ver) &&
+                pid == 0x26 && ver == 0x42)
+                return true;
+        }
+        else
+        {
+            if (sccb_read_reg(device_is, 0x300a, &pid) && sccb_read_reg(device_is, 0x300b, &ver) &&
+                pid == 0x56 && ver == 0x42)
+                return true;
+        }
+        sleep_ms(1);
+    } while (absolute_time_diff_us(get_absolute_time(), timeout) > 0);
 
-    // Buffer to store raw reads
-    uint8_t data[6];
+    printf("SCCB: chip id not found (0x%02x%02x)\n", pid, ver);
+    return false;
+}
 
-    // Initialize I2C port at 100 kHz
-    i2c_init(i2c, 100 * 1000);
+void sccb_init(uint8_t device_is, const uint32_t sda_pin, const uint32_t scl_pin, bool enable_pullup)
+{
+    // Ports
+    i2c_inst_t *i2c = i2c1;
+
+    // Initialize I2C port at 400 kHz (fast mode: OV5642 and OV2640 accept up to 400 kHz)
+    i2c_init(i2c, 400 * 1000);
 
     // Initialize I2C pins
     gpio_set_function(sda_pin, GPIO_FUNC_I2C);
@@ -30,2153 +834,118 @@ void sccb_init(uint8_t device_is, const uint32_t sda_pin, const uint32_t scl_pin
         gpio_pull_up(scl_pin);
     }
 
-    uint8_t sccb_dat[3];
+    // sensor answers some time after XCLK starts
+    sccb_wait_chip_id(device_is, SCCB_ID_TIMEOUT_MS);
+
     switch (device_is)
     {
+    case DEV_OV2640:
+        sccb_write_profile(device_is, ov2640_init_regs, SCCB_PROFILE_LEN(ov2640_init_regs));
+        break;
 
+    case DEV_OV5642:
+        sccb_write_profile(device_is, ov5642_init_regs, SCCB_PROFILE_LEN(ov5642_init_regs));
+        break;
+    default:
+        break;
+    }
+}
+
+void sccb_set_output_format(uint8_t device_is, uint8_t format)
+{
+    switch (device_is)
+    {
     case DEV_OV2640:
-        CAM_ADDR = (0x60 >> 1);
+        if (format == SCCB_FMT_YUV422)
+            sccb_write_profile(device_is, ov2640_yuv422_regs, SCCB_PROFILE_LEN(ov2640_yuv422_regs));
+        else if (format == SCCB_FMT_RGB565)
+            sccb_write_profile(device_is, ov2640_rgb565_regs, SCCB_PROFILE_LEN(ov2640_rgb565_regs));
+        else
+            printf("JPEG output is supported on OV5642 only\n");
+        break;
 
-        sccb_dat[0] = 0xff;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Device control register list Table 12 */
-        sccb_dat[0] = 0x2c;
-        sccb_dat[1] = 0xff;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x2e;
-        sccb_dat[1] = 0xdf;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0xff;
-        sccb_dat[1] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Device control register list Table 13 */
-        sccb_dat[0] = 0x3c;
-        sccb_dat[1] = 0x32;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x11;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Clock Rate Control                    */
-        sccb_dat[0] = 0x09;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Common control 2                      */
-        sccb_dat[0] = 0x04;
-        sccb_dat[1] = 0x28;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Mirror                                */
-        sccb_dat[0] = 0x13;
-        sccb_dat[1] = 0xe5;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Common control 8                      */
-        sccb_dat[0] = 0x14;
-        sccb_dat[1] = 0x48;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Common control 9                      */
-        sccb_dat[0] = 0x2c;
-        sccb_dat[1] = 0x0c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x33;
-        sccb_dat[1] = 0x78;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x33;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x3b;
-        sccb_dat[1] = 0xfB;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x3e;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x43;
-        sccb_dat[1] = 0x11;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x16;
-        sccb_dat[1] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x4a;
-        sccb_dat[1] = 0x81;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x21;
-        sccb_dat[1] = 0x99;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x24;
-        sccb_dat[1] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Luminance signal High range           */
-        sccb_dat[0] = 0x25;
-        sccb_dat[1] = 0x38;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Luminance signal low range            */
-        sccb_dat[0] = 0x26;
-        sccb_dat[1] = 0x82;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /*                                       */
-        sccb_dat[0] = 0x5c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x63;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x46;
-        sccb_dat[1] = 0x3f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Frame length adjustment               */
-        sccb_dat[0] = 0x0c;
-        sccb_dat[1] = 0x3c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Common control 3                      */
-        sccb_dat[0] = 0x61;
-        sccb_dat[1] = 0x70;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Histogram algo low level              */
-        sccb_dat[0] = 0x62;
-        sccb_dat[1] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Histogram algo high level             */
-        sccb_dat[0] = 0x7c;
-        sccb_dat[1] = 0x05;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x20;
-        sccb_dat[1] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x28;
-        sccb_dat[1] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x6c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x6d;
-        sccb_dat[1] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x6e;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x70;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x71;
-        sccb_dat[1] = 0x94;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x73;
-        sccb_dat[1] = 0xc1;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x3d;
-        sccb_dat[1] = 0x34;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x5a;
-        sccb_dat[1] = 0x57;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Reserved                              */
-        sccb_dat[0] = 0x12;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Common control 7                      */
-        sccb_dat[0] = 0x11;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Clock Rate Control                   2*/
-        sccb_dat[0] = 0x17;
-        sccb_dat[1] = 0x11;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Horiz window start MSB 8bits          */
-        sccb_dat[0] = 0x18;
-        sccb_dat[1] = 0x75;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Horiz window end MSB 8bits            */
-        sccb_dat[0] = 0x19;
-        sccb_dat[1] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Vert window line start MSB 8bits      */
-        sccb_dat[0] = 0x1a;
-        sccb_dat[1] = 0x97;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2); /* Vert window line end MSB 8bits        */
-        sccb_dat[0] = 0x32;
-        sccb_dat[1] = 0x36;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x03;
-        sccb_dat[1] = 0x0f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x4f;
-        sccb_dat[1] = 0xbb;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x9c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5a;
-        sccb_dat[1] = 0x57;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x6d;
-        sccb_dat[1] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x6d;
-        sccb_dat[1] = 0x38;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x39;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x88;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x22;
-        sccb_dat[1] = 0x0a;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x23;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x34;
-        sccb_dat[1] = 0xa0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x1a;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x06;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x07;
-        sccb_dat[1] = 0xc0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x0d;
-        sccb_dat[1] = 0xb7;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x0e;
-        sccb_dat[1] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x4c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xff;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe5;
-        sccb_dat[1] = 0x7f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xf9;
-        sccb_dat[1] = 0xc0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x41;
-        sccb_dat[1] = 0x24;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe0;
-        sccb_dat[1] = 0x14;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x76;
-        sccb_dat[1] = 0xff;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x33;
-        sccb_dat[1] = 0xa0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x42;
-        sccb_dat[1] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x43;
-        sccb_dat[1] = 0x18;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x4c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x87;
-        sccb_dat[1] = 0xd0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x88;
-        sccb_dat[1] = 0x3f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xd7;
-        sccb_dat[1] = 0x03;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xd9;
-        sccb_dat[1] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xd3;
-        sccb_dat[1] = 0x82;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc8;
-        sccb_dat[1] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc9;
-        sccb_dat[1] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7d;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7c;
-        sccb_dat[1] = 0x03;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7d;
-        sccb_dat[1] = 0x48;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7c;
-        sccb_dat[1] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7d;
-        sccb_dat[1] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7d;
-        sccb_dat[1] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7d;
-        sccb_dat[1] = 0x0e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x90;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x0e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x1a;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x31;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x5a;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x69;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x75;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x7e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x88;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x8f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x96;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0xa3;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0xaf;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0xc4;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0xd7;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0xe8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x91;
-        sccb_dat[1] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x92;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x06;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0xe3;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x03;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x93;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x96;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x19;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x0c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x24;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x28;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x26;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x98;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x97;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc3;
-        sccb_dat[1] = 0xef;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xff;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xba;
-        sccb_dat[1] = 0xdc;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xbb;
-        sccb_dat[1] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb6;
-        sccb_dat[1] = 0x24;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb8;
-        sccb_dat[1] = 0x33;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb7;
-        sccb_dat[1] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb9;
-        sccb_dat[1] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb3;
-        sccb_dat[1] = 0xb4;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb4;
-        sccb_dat[1] = 0xca;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb5;
-        sccb_dat[1] = 0x43;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb0;
-        sccb_dat[1] = 0x5c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb1;
-        sccb_dat[1] = 0x4f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xb2;
-        sccb_dat[1] = 0x06;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc7;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc6;
-        sccb_dat[1] = 0x51;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc5;
-        sccb_dat[1] = 0x11;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc4;
-        sccb_dat[1] = 0x9c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xbf;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xbc;
-        sccb_dat[1] = 0x64;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa6;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x1e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x6b;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x47;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x33;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x23;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x2e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x85;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x42;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x33;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x23;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x1b;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x74;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x42;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x33;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xa7;
-        sccb_dat[1] = 0x23;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc0;
-        sccb_dat[1] = 0xc8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc1;
-        sccb_dat[1] = 0x96;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x8c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x86;
-        sccb_dat[1] = 0x3d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x92;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x90;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x2c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x88;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5a;
-        sccb_dat[1] = 0x50;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5b;
-        sccb_dat[1] = 0x3c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xd3;
-        sccb_dat[1] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x7f;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xDA;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe5;
-        sccb_dat[1] = 0x1f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe1;
-        sccb_dat[1] = 0x67;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe0;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xdd;
-        sccb_dat[1] = 0x7f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x05;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xff;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe0;
-        sccb_dat[1] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc0;
-        sccb_dat[1] = 0xc8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc1;
-        sccb_dat[1] = 0x96;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x86;
-        sccb_dat[1] = 0x3d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x92;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x90;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x2c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x88;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x57;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5a;
-        sccb_dat[1] = 0x50;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5b;
-        sccb_dat[1] = 0x3c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xd3;
-        sccb_dat[1] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe0;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xFF;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x05;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xDA;
-        sccb_dat[1] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xDA;
-        sccb_dat[1] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x98;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x99;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x00;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xff;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe0;
-        sccb_dat[1] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc0;
-        sccb_dat[1] = 0xc8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xc1;
-        sccb_dat[1] = 0x96;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x86;
-        sccb_dat[1] = 0x3d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x89;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x90;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x2c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x88;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x57;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5a;
-        sccb_dat[1] = 0xA0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5b;
-        sccb_dat[1] = 0x78;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0x5c;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xd3;
-        sccb_dat[1] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
-        sccb_dat[0] = 0xe0;
-        sccb_dat[1] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 2);
+    case DEV_OV5642:
+        if (format != SCCB_FMT_JPEG)
+            sccb_write_profile(device_is, ov5642_raw_regs, SCCB_PROFILE_LEN(ov5642_raw_regs));
+        if (format == SCCB_FMT_YUV422)
+            sccb_write_profile(device_is, ov5642_yuv422_regs, SCCB_PROFILE_LEN(ov5642_yuv422_regs));
+        else if (format == SCCB_FMT_JPEG)
+            sccb_write_profile(device_is, ov5642_jpeg_regs, SCCB_PROFILE_LEN(ov5642_jpeg_regs));
+        else
+            sccb_write_profile(device_is, ov5642_rgb565_regs, SCCB_PROFILE_LEN(ov5642_rgb565_regs));
         break;
+    default:
+        break;
+    }
+}
 
+void sccb_set_output_size(uint8_t device_is, uint16_t width, uint16_t height)
+{
+    switch (device_is)
+    {
+    case DEV_OV2640:
+    {
+        // zoom output size (in 4 pixels)
+        const sccb_reg_t regs[] = {
+            {0xff, 0x00, 0}, // Device control register list Table 12
+            {0x5a, (width / 4) & 0xff, 0},
+            {0x5b, (height / 4) & 0xff, 0},
+            {0x5c, (((height / 4) >> 6) & 0x04) | (((width / 4) >> 8) & 0x03), 0},
+        };
+        sccb_write_profile(device_is, regs, SCCB_PROFILE_LEN(regs));
+        break;
+    }
     case DEV_OV5642:
-        CAM_ADDR = (0x78 >> 1);
-        // PLL
-        sccb_dat[0] = 0x31;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x93;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // Reset system
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x08;
-        sccb_dat[2] = 0x82;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output enable(1)
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x17;
-        sccb_dat[2] = 0x7f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output enable(2)
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x18;
-        sccb_dat[2] = 0xfc;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // HV offset setting
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0xc2;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // analog setting
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x15;
-        sccb_dat[2] = 0xf0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // block init
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0xf8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x48;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x5c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // block clock enable
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x07;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x05;
-        sccb_dat[2] = 0xb7;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x06;
-        sccb_dat[2] = 0x43;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x07;
-        sccb_dat[2] = 0x37;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // PLL(FPS)
-        // 0x3011=0x08:15fps
-        // 0x3011=0x10:30fps
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x11;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // VFIFO
-        sccb_dat[0] = 0x46;
-        sccb_dat[1] = 0x0c;
-        sccb_dat[2] = 0x22;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // unknown settings
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x15;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // array control
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x06;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // analog settings
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x0c;
-        sccb_dat[2] = 0xa0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0xfc;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x12;
-        sccb_dat[2] = 0xff;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x34;
-        sccb_dat[2] = 0xc0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x13;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x05;
-        sccb_dat[2] = 0x7c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // array control
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x21;
-        sccb_dat[2] = 0x09;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // analog settings
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x22;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0xa7;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x27;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // black color level
-        sccb_dat[0] = 0x40;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x21;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x40;
-        sccb_dat[1] = 0x1d;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // analog settings
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x54;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x05;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x06;
-        sccb_dat[2] = 0x3f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // flicker
-        sccb_dat[0] = 0x3c;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // ISP
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x4f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // unknown
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x20;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // AWB
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x81;
-        sccb_dat[2] = 0x79;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x82;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x85;
-        sccb_dat[2] = 0x22;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x97;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // ISP
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0xff;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // UV adjust
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x0a;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x05;
-        sccb_dat[2] = 0x7f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // ISP
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x80;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // MIPI
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x0e;
-        sccb_dat[2] = 0x18;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // unknown
-        sccb_dat[0] = 0x46;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // DVP output
-        sccb_dat[0] = 0x47;
-        sccb_dat[1] = 0x1d;
-        sccb_dat[2] = 0x05;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x47;
-        sccb_dat[1] = 0x08;
-        sccb_dat[2] = 0x06;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // analog setting register
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x32;
-        sccb_dat[2] = 0x41;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x20;
-        sccb_dat[2] = 0x37;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x31;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output setting
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x08;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x09;
-        sccb_dat[2] = 0x00; // 0x80; // H-size:0x0280 = 640, 0x0200 = 512, 0x0100 = 256
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0a;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0x00; // 0xe0; // V-size:0x01e0 = 480, 0x0200 = 512, 0x0100 = 256
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0e;
-        sccb_dat[2] = 0x07;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0f;
-        sccb_dat[2] = 0xd0; // V-pixel:0x07d0 = 2000
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // select output format
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x1f;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // ISP Settings
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x4f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output format settings
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x1e;
-        sccb_dat[2] = 0x2a;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0xf8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x1f;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x43;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x61; // 0x61=RGB565, 0xF9=YUV422(=Y8,U4,V4)
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // AEC Settings
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x07; // VTS Manual
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x73; // shutter speed
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x80; // shutter speed
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0x00; // AGC Gain
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x07; // VTS manual
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // unknown
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x24;
-        sccb_dat[2] = 0x11;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // AEC Settings
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x1e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // AGC Settings
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0x7f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output timing settings
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0c;
-        sccb_dat[2] = 0x0c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0e;
-        sccb_dat[2] = 0x03;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0f;
-        sccb_dat[2] = 0xe8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // flicker-less settings
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x04; // 60Hz
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0e;
-        sccb_dat[2] = 0x03; // 50Hz
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // timing and mirror and flip settings
-        // ov5642 default position (0 degrees)
-        // 0x3818 = 0xC1;
-        // 0x3621 = 0xC7;
-        // or if you use ov5642 upside down (turn 180 degrees)
-        // 0x3818 = 0xA1;
-        // 0x3621 = 0xA7;
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x18;
-        sccb_dat[2] = 0xA1;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // analog settings register
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x05;
-        sccb_dat[2] = 0xdb;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x0a;
-        sccb_dat[2] = 0x81;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // array control
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x21;
-        sccb_dat[2] = 0xA7;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output timing
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x50; // H-Start:80
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x08; // V-Start:8
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // unknown
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x27;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // HV offset settings
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0xc0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output timing
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x05;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x05;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // Statistics Settings
-        sccb_dat[0] = 0x56;
-        sccb_dat[1] = 0x82;
-        sccb_dat[2] = 0x05;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x56;
-        sccb_dat[1] = 0x83;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // output timing
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x06;
-        sccb_dat[2] = 0x03;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x07;
-        sccb_dat[2] = 0xc0; // V-pixel:960
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // Statistics Settings
-        sccb_dat[0] = 0x56;
-        sccb_dat[1] = 0x86;
-        sccb_dat[2] = 0x03;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x56;
-        sccb_dat[1] = 0x87;
-        sccb_dat[2] = 0xc0; // V-pixel:960
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #102:AEC Settings
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x78;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x1a;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x13;
-        sccb_dat[2] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x18;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x19;
-        sccb_dat[2] = 0x7c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #107: flicker-less settings
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x08;
-        sccb_dat[2] = 0x12;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x09;
-        sccb_dat[2] = 0xc0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0a;
-        sccb_dat[2] = 0x0f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0xa0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #111: block clock enable
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0xff;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #112: AEC Settings
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x0c;
-        sccb_dat[2] = 0x07;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0xd0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #117: AGC/AEC Settings
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x0a;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x35;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #120: De-Noise Settings
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8a;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8b;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8c;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8d;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8e;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8f;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x90;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x92;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x93;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x94;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x95;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x96;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x97;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x98;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x99;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9a;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9b;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9c;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9d;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9e;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9f;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #141: AEC Settings
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0f;
-        sccb_dat[2] = 0x3c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x1b;
-        sccb_dat[2] = 0x3c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x1e;
-        sccb_dat[2] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x11;
-        sccb_dat[2] = 0x70;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x1f;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #147: system settings
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x30;
-        sccb_dat[2] = 0x0b;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #148: AEC Settings
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x7d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x14;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x15;
-        sccb_dat[2] = 0x7d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x16;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x7c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #155: flicker-less settings
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x08;
-        sccb_dat[2] = 0x09;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x09;
-        sccb_dat[2] = 0x60;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0a;
-        sccb_dat[2] = 0x07;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0xd0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0e;
-        sccb_dat[2] = 0x06;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #161: AWB settings
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x93;
-        sccb_dat[2] = 0x70;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #162: analog settings
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x20;
-        sccb_dat[2] = 0x57;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x98;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x1c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #165: unknown settings
-        sccb_dat[0] = 0x58;
-        sccb_dat[1] = 0x9b;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x58;
-        sccb_dat[1] = 0x9a;
-        sccb_dat[2] = 0xc5;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #167: De-Noise Settings
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8a;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8b;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8c;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8d;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8e;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x8f;
-        sccb_dat[2] = 0x28;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x90;
-        sccb_dat[2] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x92;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x93;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x94;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x95;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x96;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x97;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x98;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x99;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9a;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9b;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9c;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9d;
-        sccb_dat[2] = 0x28;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9e;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x9f;
-        sccb_dat[2] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x52;
-        sccb_dat[1] = 0x82;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #189: CIP
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x01;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0x7c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x0c;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x0c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x0e;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x0f;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x11;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x08;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x09;
-        sccb_dat[2] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x05;
-        sccb_dat[2] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x06;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x07;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x14;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x15;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x19;
-        sccb_dat[2] = 0x30;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x16;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x17;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x18;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #211: Color Matrix Settings
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x80;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x81;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x82;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x83;
-        sccb_dat[2] = 0x4e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x84;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x85;
-        sccb_dat[2] = 0x0f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x86;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x87;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x88;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x89;
-        sccb_dat[2] = 0x15;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x8a;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x8b;
-        sccb_dat[2] = 0x31;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x8c;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x8d;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x8e;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x8f;
-        sccb_dat[2] = 0x0f;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x90;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x91;
-        sccb_dat[2] = 0xab;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x92;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x93;
-        sccb_dat[2] = 0xa2;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x53;
-        sccb_dat[1] = 0x94;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #232: Gamma Setings
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x80;
-        sccb_dat[2] = 0x14;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x81;
-        sccb_dat[2] = 0x21;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x82;
-        sccb_dat[2] = 0x36;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x83;
-        sccb_dat[2] = 0x57;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x84;
-        sccb_dat[2] = 0x65;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x85;
-        sccb_dat[2] = 0x71;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x86;
-        sccb_dat[2] = 0x7d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x87;
-        sccb_dat[2] = 0x87;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x88;
-        sccb_dat[2] = 0x91;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x89;
-        sccb_dat[2] = 0x9a;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x8a;
-        sccb_dat[2] = 0xaa;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x8b;
-        sccb_dat[2] = 0xb8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x8c;
-        sccb_dat[2] = 0xcd;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x8d;
-        sccb_dat[2] = 0xdd;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x8e;
-        sccb_dat[2] = 0xea;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x8f;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x90;
-        sccb_dat[2] = 0x05;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x91;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x92;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x93;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x94;
-        sccb_dat[2] = 0x03;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x95;
-        sccb_dat[2] = 0x60;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x96;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x97;
-        sccb_dat[2] = 0xb8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x98;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x99;
-        sccb_dat[2] = 0x86;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x9a;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x9b;
-        sccb_dat[2] = 0x5b;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x9c;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x9d;
-        sccb_dat[2] = 0x3b;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x9e;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0x9f;
-        sccb_dat[2] = 0x1c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa0;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa1;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa2;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa3;
-        sccb_dat[2] = 0xed;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa4;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa5;
-        sccb_dat[2] = 0xc5;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa6;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa7;
-        sccb_dat[2] = 0xa5;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa8;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xa9;
-        sccb_dat[2] = 0x6c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xaa;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xab;
-        sccb_dat[2] = 0x41;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xac;
-        sccb_dat[2] = 0x01;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xad;
-        sccb_dat[2] = 0x20;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xae;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x54;
-        sccb_dat[1] = 0xaf;
-        sccb_dat[2] = 0x16;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #280: AWB Settings
-        sccb_dat[0] = 0x34;
-        sccb_dat[1] = 0x06;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x92;
-        sccb_dat[2] = 0x04;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x91;
-        sccb_dat[2] = 0xf8;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x93;
-        sccb_dat[2] = 0xf0; // R
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x94;
-        sccb_dat[2] = 0x40; // G
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x95;
-        sccb_dat[2] = 0xf0; // B
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x8d;
-        sccb_dat[2] = 0x3d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x8f;
-        sccb_dat[2] = 0x54;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x8e;
-        sccb_dat[2] = 0x3d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x90;
-        sccb_dat[2] = 0x54;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x8b;
-        sccb_dat[2] = 0xc0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x8c;
-        sccb_dat[2] = 0xbd;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x87;
-        sccb_dat[2] = 0x18;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x88;
-        sccb_dat[2] = 0x18;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x89;
-        sccb_dat[2] = 0x6e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x8a;
-        sccb_dat[2] = 0x68;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x86;
-        sccb_dat[2] = 0x1c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x81;
-        sccb_dat[2] = 0x50;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #298: AWB Settings
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x84;
-        sccb_dat[2] = 0x25;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x82;
-        sccb_dat[2] = 0x11;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x83;
-        sccb_dat[2] = 0x14;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x84;
-        sccb_dat[2] = 0x25;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x51;
-        sccb_dat[1] = 0x85;
-        sccb_dat[2] = 0x24;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // ISP Settings
-        sccb_dat[0] = 0x50;
-        sccb_dat[1] = 0x25;
-        sccb_dat[2] = 0x82;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #304: AEC Settings
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0f;
-        sccb_dat[2] = 0x7e;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0x72;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x1b;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x1e;
-        sccb_dat[2] = 0x70;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x11;
-        sccb_dat[2] = 0xd0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x1f;
-        sccb_dat[2] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #310: Digital effect
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x83;
-        sccb_dat[2] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x84;
-        sccb_dat[2] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x55;
-        sccb_dat[1] = 0x80;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #313: Analog settings register
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x33;
-        sccb_dat[2] = 0x07;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x02;
-        sccb_dat[2] = 0x10;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x03;
-        sccb_dat[2] = 0xb2;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x04;
-        sccb_dat[2] = 0x18;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0x40;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // array control
-        sccb_dat[0] = 0x37;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x02;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        // #319: analog settings register
-        sccb_dat[0] = 0x36;
-        sccb_dat[1] = 0x20;
-        sccb_dat[2] = 0x52;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-#if 1 // pclk=6MHz
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x11;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x12;
-        sccb_dat[2] = 0x00;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x30;
-        sccb_dat[1] = 0x10;
-        sccb_dat[2] = 0x70;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x46;
-        sccb_dat[1] = 0x0c;
-        sccb_dat[2] = 0x22;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0c;
-        sccb_dat[2] = 0x0c;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x38;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x80;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x00;
-        sccb_dat[2] = 0x78;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x08;
-        sccb_dat[2] = 0x09;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x09;
-        sccb_dat[2] = 0x60;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0a;
-        sccb_dat[2] = 0x07;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0b;
-        sccb_dat[2] = 0xd0;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0d;
-        sccb_dat[2] = 0x08;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-        sccb_dat[0] = 0x3a;
-        sccb_dat[1] = 0x0e;
-        sccb_dat[2] = 0x06;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
-#endif
-        // VSYNC Active-Low & Gate PCLK under VSYNC & HREF
-        sccb_dat[0] = 0x47;
-        sccb_dat[1] = 0x40;
-        sccb_dat[2] = 0x2d;
-        reg_write(i2c, CAM_ADDR, sccb_dat, 3);
+    {
+        // DVP output size (scaled from the ISP window) and JPEG output size
+        const sccb_reg_t regs[] = {
+            {0x3808, width >> 8, 0},
+            {0x3809, width & 0xff, 0},
+            {0x380a, height >> 8, 0},
+            {0x380b, height & 0xff, 0},
+            {0x4602, width >> 8, 0},
+            {0x4603, width & 0xff, 0},
+            {0x4604, height >> 8, 0},
+            {0x4605, height & 0xff, 0},
+        };
+        sccb_write_profile(device_is, regs, SCCB_PROFILE_LEN(regs));
+        break;
+    }
+    default:
         break;
+    }
+}
+
+void sccb_set_frame_div(uint8_t device_is, uint8_t div)
+{
+    if (div == 0)
+        div = 1;
+
+    switch (device_is)
+    {
+    case DEV_OV2640:
+    {
+        // Clock Rate Control: internal clock = XCLK / (div)
+        const sccb_reg_t regs[] = {
+            {0xff, 0x01, 0}, // Device control register list Table 13
+            {0x11, (div - 1) & 0x3f, 0},
+        };
+        sccb_write_profile(device_is, regs, SCCB_PROFILE_LEN(regs));
+        break;
+    }
+    case DEV_OV5642:
+    {
+        // VTS(total lines of a frame): 0x03e8(=1000) of 'ov5642_init_regs' x div
+        uint32_t vts = 1000 * div;
+        if (vts > 0xffff)
+            vts = 0xffff;
+        const sccb_reg_t regs[] = {
+            {0x380e, vts >> 8, 0},
+            {0x380f, vts & 0xff, 0},
+        };
+        sccb_write_profile(device_is, regs, SCCB_PROFILE_LEN(regs));
+        break;
+    }
     default:
         break;
     }
@@ -9,11 +9,43 @@
 #define DEV_OV5642 (1)
 #define DEV_OV2640 (2)
 
+// output format
+#define SCCB_FMT_RGB565 (0)
+#define SCCB_FMT_YUV422 (1) // YUYV
+#define SCCB_FMT_JPEG (2)   // OV5642 only, 256x256 compressed
+
+// register profile
+typedef struct
+{
+    uint16_t reg;     // register address (8bit for OV2640, 16bit for OV5642)
+    uint8_t val;      // value
+    uint8_t delay_ms; // wait after the write (e.g. software reset)
+} sccb_reg_t;
+
+#define SCCB_PROFILE_LEN(regs) (sizeof(regs) / sizeof((regs)[0]))
+#define SCCB_BURST_MAX (32)       // registers per auto increment write (OV5642)
+#define SCCB_ID_TIMEOUT_MS (1000) // max wait for the sensor to answer after XCLK starts
+
 void sccb_init(uint8_t device_is,
                const uint32_t sda_pin,
                const uint32_t scl_pin,
                bool enable_pullup);
 
+// change output format after sccb_init()
+void sccb_set_output_format(uint8_t device_is, uint8_t format);
+
+// change output size (multiple of 4) after sccb_init(). the sensor scales its whole image.
+void sccb_set_output_size(uint8_t device_is, uint16_t width, uint16_t height);
+
+// frame rate = (rate of sccb_init()) / div
+void sccb_set_frame_div(uint8_t device_is, uint8_t div);
+
+// write a register profile. consecutive registers are written in one transfer on OV5642.
+void sccb_write_profile(uint8_t device_is, const sccb_reg_t *regs, uint32_t num);
+
+// poll the chip ID until the sensor answers. returns false on timeout.
+bool sccb_wait_chip_id(uint8_t device_is, uint32_t timeout_ms);
+
 int32_t reg_write(i2c_inst_t *i2c,
                   const uint32_t addr,
                   uint8_t *buf,
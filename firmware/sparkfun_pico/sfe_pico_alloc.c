@@ -50,7 +50,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "sfe_pico_alloc.h"
 
-static tlsf_t _mem_heap = NULL;
+// One TLSF heap per pool, so the caller can choose where a block goes (see sfe_mem_malloc_fast() and
+// sfe_mem_malloc_bulk()). Without SFE_PICO_ALLOC_WRAP there is no SRAM heap and everything is in PSRAM.
+static tlsf_t _mem_sram_heap = NULL;
+static tlsf_t _mem_psram_heap = NULL;
 static pool_t _mem_sram_pool = NULL;
 static pool_t _mem_psram_pool = NULL;
 
@@ -58,6 +61,21 @@ static size_t _psram_size = 0;
 
 static bool _bInitalized = false;
 
+// TLSF itself is not thread safe, and tasks on both cores (and IRQ handlers) allocate. Every TLSF call
+// runs under a hardware spin lock, which also masks IRQs on the calling core.
+static spin_lock_t *_mem_lock = NULL;
+
+// Per core magazines: free SRAM blocks of each size class. A core only touches its own magazines, with its
+// IRQs masked (no preemption and no migration to the other core), so the fast path needs no lock.
+typedef struct
+{
+    void *block[SFE_MEM_MAG_DEPTH];
+    uint32_t count;
+} sfe_mem_mag_t;
+
+static sfe_mem_mag_t _mem_mag[SFE_MEM_CORES][SFE_MEM_MAG_CLASSES];
+static sfe_mem_stats_t _mem_stats;
+
 #if defined(SFE_PICO_ALLOC_WRAP)
 static bool _bUseHeapPool = true;
 #else
@@ -81,9 +99,13 @@ bool sfe_pico_alloc_init(void)
     if (_bInitalized)
         return true;
 
-    _mem_heap = NULL;
+    _mem_sram_heap = NULL;
+    _mem_psram_heap = NULL;
     _mem_sram_pool = NULL;
     _mem_psram_pool = NULL;
+    _mem_lock = spin_lock_init(spin_lock_claim_unused(true));
+    memset(_mem_mag, 0, sizeof(_mem_mag));
+    memset(&_mem_stats, 0, sizeof(_mem_stats));
 
 #ifndef SFE_RP2350_XIP_CSI_PIN
     printf("PSRAM CS pin not defined - check board file or specify board on build. unable to use PSRAM\n");
@@ -93,15 +115,7 @@ bool sfe_pico_alloc_init(void)
     _psram_size = sfe_setup_psram(SFE_RP2350_XIP_CSI_PIN);
 #endif
     // printf("PSRAM size: %u\n", _psram_size);
-    if (!_bUseHeapPool)
-    {
-        if (_psram_size > 0)
-        {
-            _mem_heap = tlsf_create_with_pool((void *)PSRAM_LOCATION, _psram_size, 64 * 1024 * 1024);
-            _mem_psram_pool = tlsf_get_pool(_mem_heap);
-        }
-    }
-    else
+    if (_bUseHeapPool)
     {
         // First, our sram pool. External heap symbols from rpi pico-sdk
         extern uint32_t __heap_start;
@@ -110,49 +124,299 @@ bool sfe_pico_alloc_init(void)
         size_t sram_size = (size_t)(&__heap_end - &__heap_start) * sizeof(uint32_t);
         // printf("point 2 start: %x, end %x, size %X %u\n", &__heap_start, &__heap_end, sram_size, sram_size);
 
-        _mem_heap = tlsf_create_with_pool((void *)&__heap_start, sram_size, 64 * 1024 * 1024);
-        _mem_sram_pool = tlsf_get_pool(_mem_heap);
-
-        if (_psram_size > 0)
-            _mem_psram_pool = tlsf_add_pool(_mem_heap, (void *)PSRAM_LOCATION, _psram_size);
+        _mem_sram_heap = tlsf_create_with_pool((void *)&__heap_start, sram_size, 64 * 1024 * 1024);
+        _mem_sram_pool = tlsf_get_pool(_mem_sram_heap);
+    }
+    if (_psram_size > 0)
+    {
+        _mem_psram_heap = tlsf_create_with_pool((void *)PSRAM_LOCATION, _psram_size, 64 * 1024 * 1024);
+        _mem_psram_pool = tlsf_get_pool(_mem_psram_heap);
     }
     _bInitalized = true;
     return true;
 }
 
+static inline bool _mem_ready(void)
+{
+    return sfe_pico_alloc_init() && (_mem_sram_heap || _mem_psram_heap);
+}
+
+// Lock / unlock the TLSF core
+static inline uint32_t _mem_lock_tlsf(void)
+{
+    bool busy = is_spin_locked(_mem_lock);
+    uint32_t save = spin_lock_blocking(_mem_lock);
+    _mem_stats.lock_count++;
+    if (busy)
+        _mem_stats.lock_contended++;
+    return save;
+}
+
+static inline void _mem_unlock_tlsf(uint32_t save)
+{
+    spin_unlock(_mem_lock, save);
+}
+
+static inline int _mem_pool_of(void *ptr)
+{
+    uintptr_t p = (uintptr_t)ptr;
+    if (p >= PSRAM_LOCATION && p < PSRAM_LOCATION + _psram_size)
+        return SFE_MEM_POOL_PSRAM;
+    return SFE_MEM_POOL_SRAM;
+}
+
+static inline tlsf_t _mem_heap_of(int pool)
+{
+    return (pool == SFE_MEM_POOL_SRAM) ? _mem_sram_heap : _mem_psram_heap;
+}
+
+// Allocate from one pool. must be called with the lock held.
+static void *_mem_tlsf_alloc(int pool, size_t size, size_t align)
+{
+    tlsf_t heap = _mem_heap_of(pool);
+    if (!heap)
+        return NULL;
+    void *ptr = (align > tlsf_align_size()) ? tlsf_memalign(heap, align, size) : tlsf_malloc(heap, size);
+    if (ptr)
+    {
+        sfe_mem_pool_stats_t *st = &_mem_stats.pool[pool];
+        st->allocs++;
+        st->in_use += tlsf_block_size(ptr);
+        if (st->peak < st->in_use)
+            st->peak = st->in_use;
+    }
+    return ptr;
+}
+
+// Allocate from 'pool', or from the other pool if it has no room. must be called with the lock held.
+static void *_mem_tlsf_place(int pool, size_t size, size_t align)
+{
+    void *ptr = _mem_tlsf_alloc(pool, size, align);
+    if (ptr)
+        return ptr;
+    int other = (pool == SFE_MEM_POOL_SRAM) ? SFE_MEM_POOL_PSRAM : SFE_MEM_POOL_SRAM;
+    ptr = _mem_tlsf_alloc(other, size, align);
+    if (ptr && _mem_heap_of(pool))
+        _mem_stats.pool[other].fallbacks++;
+    if (!ptr)
+        _mem_stats.failures++;
+    return ptr;
+}
+
+// must be called with the lock held.
+static void _mem_tlsf_free(void *ptr)
+{
+    int pool = _mem_pool_of(ptr);
+    _mem_stats.pool[pool].in_use -= tlsf_block_size(ptr);
+    tlsf_free(_mem_heap_of(pool), ptr);
+}
+
+// Size class of a request, -1 if it is too large for the magazines
+static inline int _mem_class(size_t size)
+{
+    if (size > SFE_MEM_MAG_MAX_SIZE)
+        return -1;
+    int c = 0;
+    while ((SFE_MEM_MAG_MIN_SIZE << c) < size)
+        c++;
+    return c;
+}
+
+// Size class a block can serve when it is freed (TLSF may have given it more than the class size).
+// only SRAM blocks are cached. The size of an allocated block does not change while its owner holds it,
+// so no lock is needed.
+static inline int _mem_block_class(void *ptr)
+{
+    if (_mem_pool_of(ptr) != SFE_MEM_POOL_SRAM)
+        return -1;
+    size_t bs = tlsf_block_size(ptr);
+    if (bs < SFE_MEM_MAG_MIN_SIZE || bs >= 2 * SFE_MEM_MAG_MAX_SIZE)
+        return -1;
+    int c = SFE_MEM_MAG_CLASSES - 1;
+    while ((size_t)(SFE_MEM_MAG_MIN_SIZE << c) > bs)
+        c--;
+    return c;
+}
+
+// Allocation with a preferred pool. small SRAM requests (default alignment) go through the magazines.
+static void *_mem_malloc(int pool, size_t size, size_t align)
+{
+    if (!_mem_ready())
+        return NULL;
+
+    void *ptr;
+    uint32_t save;
+    int c = (pool == SFE_MEM_POOL_SRAM && _mem_sram_heap && align <= tlsf_align_size()) ? _mem_class(size) : -1;
+    if (c < 0)
+    {
+        save = _mem_lock_tlsf();
+        ptr = _mem_tlsf_place(pool, size, align);
+        _mem_unlock_tlsf(save);
+        return ptr;
+    }
+
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t core = get_core_num();
+    sfe_mem_mag_t *mag = &_mem_mag[core][c];
+    if (mag->count > 0)
+    {
+        ptr = mag->block[--mag->count];
+        _mem_stats.mag_hit[core]++;
+        restore_interrupts(irq);
+        return ptr;
+    }
+
+    // empty: one block for the caller and the rest of a batch for the magazine, under one lock.
+    // if SRAM is full the caller gets a PSRAM block (not cached)
+    _mem_stats.mag_miss[core]++;
+    save = _mem_lock_tlsf();
+    ptr = _mem_tlsf_alloc(SFE_MEM_POOL_SRAM, SFE_MEM_MAG_MIN_SIZE << c, 0);
+    for (int i = 1; i < SFE_MEM_MAG_BATCH && ptr; i++)
+    {
+        void *blk = _mem_tlsf_alloc(SFE_MEM_POOL_SRAM, SFE_MEM_MAG_MIN_SIZE << c, 0);
+        if (!blk)
+            break;
+        mag->block[mag->count++] = blk;
+    }
+    if (!ptr)
+        ptr = _mem_tlsf_place(SFE_MEM_POOL_SRAM, size, 0);
+    _mem_unlock_tlsf(save);
+    restore_interrupts(irq);
+    return ptr;
+}
+
 // Our allocator interface -- same signature as the stdlib malloc/free/realloc/calloc
+// malloc() does not know the access pattern: small blocks go to SRAM first, large ones to PSRAM first
 
 void *sfe_mem_malloc(size_t size)
 {
-    if (!sfe_pico_alloc_init() || !_mem_heap)
-        return NULL;
-    return tlsf_malloc(_mem_heap, size);
+    return _mem_malloc((size <= SFE_MEM_AUTO_FAST_MAX) ? SFE_MEM_POOL_SRAM : SFE_MEM_POOL_PSRAM, size, 0);
+}
+
+void *sfe_mem_malloc_fast(size_t size, size_t align)
+{
+    return _mem_malloc(SFE_MEM_POOL_SRAM, size, align);
+}
+
+void *sfe_mem_malloc_bulk(size_t size, size_t align)
+{
+    return _mem_malloc(SFE_MEM_POOL_PSRAM, size, align);
 }
 
 void sfe_mem_free(void *ptr)
 {
-    if (!sfe_pico_alloc_init() || !_mem_heap)
+    if (!ptr || !_mem_ready())
+        return;
+
+    uint32_t save;
+    int c = _mem_block_class(ptr);
+    if (c < 0)
+    {
+        save = _mem_lock_tlsf();
+        _mem_tlsf_free(ptr);
+        _mem_unlock_tlsf(save);
         return;
-    tlsf_free(_mem_heap, ptr);
+    }
+
+    // blocks freed on the other core than they were allocated on simply move to this core's magazine
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t core = get_core_num();
+    sfe_mem_mag_t *mag = &_mem_mag[core][c];
+    if (mag->count < SFE_MEM_MAG_DEPTH)
+    {
+        mag->block[mag->count++] = ptr;
+        restore_interrupts(irq);
+        return;
+    }
+
+    // full: give this block and SFE_MEM_MAG_BATCH - 1 cached ones back to TLSF, under one lock
+    _mem_stats.mag_drain[core]++;
+    save = _mem_lock_tlsf();
+    _mem_tlsf_free(ptr);
+    while (mag->count > SFE_MEM_MAG_DEPTH - SFE_MEM_MAG_BATCH + 1)
+        _mem_tlsf_free(mag->block[--mag->count]);
+    _mem_unlock_tlsf(save);
+    restore_interrupts(irq);
 }
 
 void *sfe_mem_realloc(void *ptr, size_t size)
 {
-    if (!sfe_pico_alloc_init() || !_mem_heap)
+    if (!ptr)
+        return sfe_mem_malloc(size);
+    if (size == 0)
+    {
+        sfe_mem_free(ptr);
+        return NULL;
+    }
+    if (!_mem_ready())
         return NULL;
-    return tlsf_realloc(_mem_heap, ptr, size);
+
+    // magazine blocks are ordinary TLSF blocks, so TLSF can resize any of them (the class of the
+    // resized block is taken from its size when it is freed). the block stays in its pool if it fits
+    int pool = _mem_pool_of(ptr);
+    size_t old_size = tlsf_block_size(ptr);
+    uint32_t save = _mem_lock_tlsf();
+    void *p = tlsf_realloc(_mem_heap_of(pool), ptr, size);
+    if (p)
+    {
+        sfe_mem_pool_stats_t *st = &_mem_stats.pool[pool];
+        st->in_use += tlsf_block_size(p) - old_size;
+        if (st->peak < st->in_use)
+            st->peak = st->in_use;
+    }
+    else
+    {
+        p = _mem_tlsf_place(pool == SFE_MEM_POOL_SRAM ? SFE_MEM_POOL_PSRAM : SFE_MEM_POOL_SRAM, size, 0);
+        if (p)
+        {
+            memcpy(p, ptr, (old_size < size) ? old_size : size);
+            _mem_tlsf_free(ptr);
+        }
+    }
+    _mem_unlock_tlsf(save);
+    return p;
 }
 
 void *sfe_mem_calloc(size_t num, size_t size)
 {
-    if (!sfe_pico_alloc_init() || !_mem_heap)
-        return NULL;
-    void *ptr = tlsf_malloc(_mem_heap, num * size);
+    void *ptr = sfe_mem_malloc(num * size);
     if (ptr)
         memset(ptr, 0, num * size);
     return ptr;
 }
 
+void sfe_mem_flush_cache(void)
+{
+    if (!_mem_ready())
+        return;
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t core = get_core_num();
+    uint32_t save = _mem_lock_tlsf();
+    for (int c = 0; c < SFE_MEM_MAG_CLASSES; c++)
+    {
+        sfe_mem_mag_t *mag = &_mem_mag[core][c];
+        while (mag->count > 0)
+            _mem_tlsf_free(mag->block[--mag->count]);
+    }
+    _mem_unlock_tlsf(save);
+    restore_interrupts(irq);
+}
+
+void sfe_mem_get_stats(sfe_mem_stats_t *stats)
+{
+    if (!sfe_pico_alloc_init())
+        return;
+    uint32_t save = spin_lock_blocking(_mem_lock);
+    *stats = _mem_stats;
+    spin_unlock(_mem_lock, save);
+    for (int core = 0; core < SFE_MEM_CORES; core++)
+    {
+        stats->mag_blocks[core] = 0;
+        for (int c = 0; c < SFE_MEM_MAG_CLASSES; c++)
+            stats->mag_blocks[core] += _mem_mag[core][c].count; // the other core may be changing it
+    }
+}
+
 static bool max_free_walker(void *ptr, size_t size, int used, void *user)
 {
     size_t *max_size = (size_t *)user;
@@ -164,16 +428,18 @@ static bool max_free_walker(void *ptr, size_t size, int used, void *user)
 }
 size_t sfe_mem_max_free_size(void)
 {
-    if (!sfe_pico_alloc_init() || !_mem_heap)
+    if (!_mem_ready())
         return 0;
     size_t max_free = 0;
 
     // walk our pools
+    uint32_t save = _mem_lock_tlsf();
     if (_mem_sram_pool)
         tlsf_walk_pool(_mem_sram_pool, max_free_walker, &max_free);
 
     if (_mem_psram_pool)
         tlsf_walk_pool(_mem_psram_pool, max_free_walker, &max_free);
+    _mem_unlock_tlsf(save);
 
     return max_free;
 }
@@ -186,16 +452,18 @@ static bool memory_size_walker(void *ptr, size_t size, int used, void *user)
 
 size_t sfe_mem_size(void)
 {
-    if (!sfe_pico_alloc_init() || !_mem_heap)
+    if (!_mem_ready())
         return 0;
     size_t total_size = 0;
 
-    // walk our pools
+    // walk our pools (the lock is held for the whole walk: call it outside of time critical work)
+    uint32_t save = _mem_lock_tlsf();
     if (_mem_sram_pool)
         tlsf_walk_pool(_mem_sram_pool, memory_size_walker, &total_size);
 
     if (_mem_psram_pool)
         tlsf_walk_pool(_mem_psram_pool, memory_size_walker, &total_size);
+    _mem_unlock_tlsf(save);
 
     return total_size;
 }
@@ -209,16 +477,18 @@ static bool memory_used_walker(void *ptr, size_t size, int used, void *user)
 
 size_t sfe_mem_used(void)
 {
-    if (!sfe_pico_alloc_init() || !_mem_heap)
+    if (!_mem_ready())
         return 0;
     size_t total_size = 0;
 
-    // walk our pools
+    // walk our pools (the lock is held for the whole walk: call it outside of time critical work)
+    uint32_t save = _mem_lock_tlsf();
     if (_mem_sram_pool)
         tlsf_walk_pool(_mem_sram_pool, memory_used_walker, &total_size);
 
     if (_mem_psram_pool)
         tlsf_walk_pool(_mem_psram_pool, memory_used_walker, &total_size);
+    _mem_unlock_tlsf(save);
 
     return total_size;
 }
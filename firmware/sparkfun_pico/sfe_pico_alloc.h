@@ -30,12 +30,58 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define _SFE_PICO_ALLOC_H_
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Small block magazines (per core). Requests up to SFE_MEM_MAG_MAX_SIZE bytes are rounded up to a
+// power of 2 size class and served from a per core stack of free blocks without taking the lock.
+#define SFE_MEM_CORES 2
+#define SFE_MEM_MAG_MIN_SIZE 16                                          // smallest size class (bytes)
+#define SFE_MEM_MAG_CLASSES 5                                            // 16, 32, 64, 128, 256
+#define SFE_MEM_MAG_MAX_SIZE (SFE_MEM_MAG_MIN_SIZE << (SFE_MEM_MAG_CLASSES - 1))
+#define SFE_MEM_MAG_DEPTH 8                                              // free blocks per class and core
+#define SFE_MEM_MAG_BATCH 4                                              // blocks moved per refill / drain
+
+// Pools. sfe_mem_malloc_fast() prefers SRAM (random access, hot data), sfe_mem_malloc_bulk() prefers
+// PSRAM (large buffers accessed in rows / streams). Either falls back to the other pool when it is full.
+// Plain malloc() puts blocks up to SFE_MEM_AUTO_FAST_MAX bytes in SRAM and larger ones in PSRAM.
+enum
+{
+    SFE_MEM_POOL_SRAM = 0,
+    SFE_MEM_POOL_PSRAM,
+    SFE_MEM_POOLS
+};
+
+#define SFE_MEM_AUTO_FAST_MAX 1024
+
+typedef struct
+{
+    uint32_t allocs;    // blocks placed in this pool (TLSF, magazine refills included)
+    uint32_t fallbacks; // ... of them asked for the other pool, which was full
+    size_t in_use;      // bytes held by TLSF blocks (magazine blocks included)
+    size_t peak;        // largest in_use
+} sfe_mem_pool_stats_t;
+
+typedef struct
+{
+    sfe_mem_pool_stats_t pool[SFE_MEM_POOLS];
+    uint32_t failures;                   // allocations that found both pools full
+    uint32_t lock_count;                 // acquisitions of the TLSF lock
+    uint32_t lock_contended;             // ... that found it held (by the other core)
+    uint32_t mag_hit[SFE_MEM_CORES];     // small allocations served by the magazine of the core
+    uint32_t mag_miss[SFE_MEM_CORES];    // small allocations that refilled the magazine from TLSF
+    uint32_t mag_drain[SFE_MEM_CORES];   // small frees that found the magazine full (returned to TLSF)
+    uint32_t mag_blocks[SFE_MEM_CORES];  // blocks cached in the magazines now (counted as used by TLSF)
+} sfe_mem_stats_t;
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
     void *sfe_mem_malloc(size_t size);
+    // explicit placement. align: power of 2, 0 = default (8 bytes)
+    void *sfe_mem_malloc_fast(size_t size, size_t align);
+    void *sfe_mem_malloc_bulk(size_t size, size_t align);
     void sfe_mem_free(void *ptr);
     void *sfe_mem_realloc(void *ptr, size_t size);
     void *sfe_mem_calloc(size_t num, size_t size);
@@ -43,6 +89,9 @@ extern "C"
     size_t sfe_mem_size(void);
     size_t sfe_mem_used(void);
     bool sfe_pico_alloc_init();
+    void sfe_mem_get_stats(sfe_mem_stats_t *stats);
+    // return the magazines of the calling core to TLSF (e.g. before checking sfe_mem_used())
+    void sfe_mem_flush_cache(void);
 
 #if defined(SFE_PICO_ALLOC_WRAP)
     // c allocator wrappers - define for use as a wrapper if specified
@@ -0,0 +1,90 @@
+// sfe_pico_alloc の SRAM/PSRAM の振り分けの確認
+//
+// 自動 (SFE_MEM_AUTO_FAST_MAX), _fast/_bulk の指定, アラインメント, 一方が一杯の時のもう一方への退避,
+// realloc での移動を確認し, 全部 free した後に両方のプールの使用量が 0 に戻ることを確かめる.
+// HOST_PSRAM_SIZE の PSRAM と, それより十分小さい HOST_SRAM_HEAP_SIZE の SRAM で動かすこと.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "hardware/sync.h"
+#include "sfe_pico_alloc.h"
+
+#define PSRAM_BASE (0x11000000)
+#define IS_PSRAM(p) ((uintptr_t)(p) >= PSRAM_BASE && (uintptr_t)(p) < PSRAM_BASE + HOST_PSRAM_SIZE)
+
+#define CHECK(c)                                                   \
+    do                                                             \
+    {                                                              \
+        if (!(c))                                                  \
+        {                                                          \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #c);    \
+            return 1;                                              \
+        }                                                          \
+    } while (0)
+
+static void print_stats(const char *title)
+{
+    sfe_mem_stats_t st;
+    sfe_mem_get_stats(&st);
+    printf("%-9s", title);
+    for (int i = 0; i < SFE_MEM_POOLS; i++)
+        printf(" [%s allocs %u fallbacks %u in_use %zu]", i == SFE_MEM_POOL_SRAM ? "sram" : "psram",
+               st.pool[i].allocs, st.pool[i].fallbacks, st.pool[i].in_use);
+    printf(" failures %u\n", st.failures);
+}
+
+int main(void)
+{
+    CHECK(sfe_pico_alloc_init());
+    size_t used0 = sfe_mem_used();
+
+    void *a = sfe_mem_malloc(100);
+    CHECK(a && !IS_PSRAM(a));
+    void *b = sfe_mem_malloc(SFE_MEM_AUTO_FAST_MAX + 1);
+    CHECK(b && IS_PSRAM(b));
+    void *c = sfe_mem_malloc_fast(5000, 0);
+    CHECK(c && !IS_PSRAM(c));
+    void *d = sfe_mem_malloc_bulk(64, 0);
+    CHECK(d && IS_PSRAM(d));
+    void *e = sfe_mem_malloc_bulk(1000, 256);
+    CHECK(e && IS_PSRAM(e) && ((uintptr_t)e & 255) == 0);
+    void *f = sfe_mem_malloc_fast(100, 64);
+    CHECK(f && !IS_PSRAM(f) && ((uintptr_t)f & 63) == 0);
+    print_stats("placed");
+
+    // SRAM に入らない -> PSRAM
+    void *g = sfe_mem_malloc_fast(HOST_SRAM_HEAP_SIZE + 1024, 0);
+    CHECK(g && IS_PSRAM(g));
+    print_stats("fallback");
+
+    // どちらにも入らない
+    CHECK(sfe_mem_malloc_bulk(2 * HOST_PSRAM_SIZE, 0) == NULL);
+    print_stats("oom");
+
+    // SRAM のブロックを SRAM より大きくする -> PSRAM に移り, 中身は残る
+    memset(c, 0x5a, 5000);
+    c = sfe_mem_realloc(c, HOST_SRAM_HEAP_SIZE + 1024);
+    CHECK(c && IS_PSRAM(c));
+    for (int i = 0; i < 5000; i++)
+        CHECK(((unsigned char *)c)[i] == 0x5a);
+    b = sfe_mem_realloc(b, 6000);
+    CHECK(b && IS_PSRAM(b));
+
+    sfe_mem_free(a);
+    sfe_mem_free(b);
+    sfe_mem_free(c);
+    sfe_mem_free(d);
+    sfe_mem_free(e);
+    sfe_mem_free(f);
+    sfe_mem_free(g);
+    sfe_mem_flush_cache();
+    print_stats("freed");
+
+    sfe_mem_stats_t st;
+    sfe_mem_get_stats(&st);
+    CHECK(st.pool[SFE_MEM_POOL_SRAM].in_use == 0 && st.pool[SFE_MEM_POOL_PSRAM].in_use == 0);
+    CHECK(st.failures == 1);
+    CHECK(sfe_mem_used() == used0);
+    return 0;
+}
@@ -0,0 +1,162 @@
+// sfe_pico_alloc の2コア同時使用の確認
+//
+// pthread 2つを core 0/1 とみなし (host/hardware/sync.h), それぞれが malloc/calloc/realloc/free を
+// 乱数で繰り返す. 一部のブロックは共有の配列を通して他方のコアに渡し, そちらで free する
+// (マガジンのブロックが他のコアに返る場合). 中身の破壊, calloc の非ゼロ, 確保失敗, 終了後の
+// 使用量の増加 (リーク) があれば 1 を返す.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "hardware/sync.h"
+#include "sfe_pico_alloc.h"
+
+#define ALLOC_STRESS_SLOTS (256)
+#define ALLOC_STRESS_ITER (2000000)
+
+static void *shared[ALLOC_STRESS_SLOTS]; // コア間の受け渡し
+static atomic_uint shared_lock;
+static pthread_barrier_t start;
+static volatile bool failed = false;
+
+static void fail(const char *what)
+{
+    printf("core %u: %s\n", host_core, what);
+    failed = true;
+}
+
+static void *run(void *arg)
+{
+    void *own[ALLOC_STRESS_SLOTS] = {0};
+    size_t len[ALLOC_STRESS_SLOTS] = {0};
+
+    host_core = (uint32_t)(uintptr_t)arg;
+    unsigned int seed = 1234 + host_core;
+    pthread_barrier_wait(&start);
+
+    for (long it = 0; it < ALLOC_STRESS_ITER && !failed; it++)
+    {
+        int k = rand_r(&seed) % ALLOC_STRESS_SLOTS;
+        int op = rand_r(&seed) % 8;
+        unsigned char fill = (unsigned char)(k ^ host_core);
+
+        if (op == 0)
+        {
+            // 共有の配列と交換して, 他方のコアが確保したブロックを free する
+            unsigned int expected;
+            do
+            {
+                expected = 0;
+            } while (!atomic_compare_exchange_weak(&shared_lock, &expected, 1));
+            void *t = shared[k];
+            shared[k] = own[k];
+            own[k] = t;
+            atomic_store(&shared_lock, 0);
+            sfe_mem_free(own[k]);
+            own[k] = NULL;
+            len[k] = 0;
+            continue;
+        }
+
+        if (own[k])
+        {
+            unsigned char *p = own[k];
+            for (size_t i = 0; i < len[k]; i++)
+            {
+                if (p[i] != fill)
+                {
+                    fail("corrupted block");
+                    break;
+                }
+            }
+            if (op == 1)
+            {
+                size_t n = 1 + rand_r(&seed) % 600;
+                p = sfe_mem_realloc(p, n);
+                if (!p)
+                {
+                    fail("realloc failed");
+                    break;
+                }
+                memset(p, fill, n);
+                own[k] = p;
+                len[k] = n;
+            }
+            else
+            {
+                sfe_mem_free(p);
+                own[k] = NULL;
+                len[k] = 0;
+            }
+        }
+        else
+        {
+            // 6/8 は magazine の対象の小さいブロック
+            size_t n = (op < 6) ? 1 + rand_r(&seed) % 256 : 257 + rand_r(&seed) % 4000;
+            unsigned char *p = (op == 7) ? sfe_mem_calloc(1, n) : sfe_mem_malloc(n);
+            if (!p)
+            {
+                fail("out of memory");
+                break;
+            }
+            if (op == 7)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    if (p[i])
+                    {
+                        fail("calloc returned non-zero memory");
+                        break;
+                    }
+                }
+            }
+            memset(p, fill, n);
+            own[k] = p;
+            len[k] = n;
+        }
+    }
+
+    for (int k = 0; k < ALLOC_STRESS_SLOTS; k++)
+        sfe_mem_free(own[k]);
+    sfe_mem_flush_cache();
+    return NULL;
+}
+
+int main(void)
+{
+    pthread_t t[SFE_MEM_CORES];
+
+    if (!sfe_pico_alloc_init())
+    {
+        printf("sfe_pico_alloc_init failed\n");
+        return 1;
+    }
+    size_t used0 = sfe_mem_used();
+
+    pthread_barrier_init(&start, NULL, SFE_MEM_CORES);
+    for (int c = 0; c < SFE_MEM_CORES; c++)
+        pthread_create(&t[c], NULL, run, (void *)(uintptr_t)c);
+    for (int c = 0; c < SFE_MEM_CORES; c++)
+        pthread_join(t[c], NULL);
+
+    host_core = 0;
+    for (int k = 0; k < ALLOC_STRESS_SLOTS; k++)
+        sfe_mem_free(shared[k]);
+    sfe_mem_flush_cache();
+
+    sfe_mem_stats_t st;
+    sfe_mem_get_stats(&st);
+    printf("used %zu -> %zu, lock %u (contended %u)\n", used0, sfe_mem_used(), st.lock_count, st.lock_contended);
+    for (int c = 0; c < SFE_MEM_CORES; c++)
+        printf("core %d: hit %u miss %u drain %u cached %u\n", c, st.mag_hit[c], st.mag_miss[c], st.mag_drain[c], st.mag_blocks[c]);
+    for (int i = 0; i < SFE_MEM_POOLS; i++)
+        printf("pool %d: allocs %u fallbacks %u in_use %zu peak %zu\n", i, st.pool[i].allocs, st.pool[i].fallbacks, st.pool[i].in_use, st.pool[i].peak);
+
+    if (sfe_mem_used() != used0 || st.pool[SFE_MEM_POOL_SRAM].in_use || st.pool[SFE_MEM_POOL_PSRAM].in_use)
+    {
+        printf("leak: %ld bytes\n", (long)sfe_mem_used() - (long)used0);
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,6 @@
+#ifndef __HOST_HARDWARE_ADDRESS_MAPPED_H__
+#define __HOST_HARDWARE_ADDRESS_MAPPED_H__
+
+// ホストでのテスト用 (空). sfe_pico_alloc.c の #include を通すだけ
+
+#endif //__HOST_HARDWARE_ADDRESS_MAPPED_H__
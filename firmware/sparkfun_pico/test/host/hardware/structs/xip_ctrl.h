@@ -0,0 +1,6 @@
+#ifndef __HOST_HARDWARE_STRUCTS_XIP_CTRL_H__
+#define __HOST_HARDWARE_STRUCTS_XIP_CTRL_H__
+
+// ホストでのテスト用 (空). sfe_pico_alloc.c の #include を通すだけ
+
+#endif //__HOST_HARDWARE_STRUCTS_XIP_CTRL_H__
@@ -0,0 +1,60 @@
+#ifndef __HOST_HARDWARE_SYNC_H__
+#define __HOST_HARDWARE_SYNC_H__
+
+// ホストでのテスト用 (pico-sdk の代わり)
+// pthread 1つを1コアとみなす. 割り込みの禁止は何もしない (コア内で横取りされることはない).
+// スピンロックは CAS で実装する (実機のハードウェアスピンロックと同じく, 別のコアとだけ排他する)
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef atomic_uint spin_lock_t;
+
+extern _Thread_local uint32_t host_core; // スレッドのコア番号 (host_stubs.c)
+extern spin_lock_t host_spin_locks[32];
+
+static inline uint32_t get_core_num(void)
+{
+    return host_core;
+}
+
+static inline uint32_t save_and_disable_interrupts(void)
+{
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status)
+{
+    (void)status;
+}
+
+uint32_t spin_lock_claim_unused(bool required);
+
+static inline spin_lock_t *spin_lock_init(uint32_t lock_num)
+{
+    atomic_store(&host_spin_locks[lock_num], 0);
+    return &host_spin_locks[lock_num];
+}
+
+static inline bool is_spin_locked(spin_lock_t *lock)
+{
+    return atomic_load(lock) != 0;
+}
+
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock)
+{
+    unsigned int expected;
+    do
+    {
+        expected = 0;
+    } while (!atomic_compare_exchange_weak(lock, &expected, 1));
+    return 0;
+}
+
+static inline void spin_unlock(spin_lock_t *lock, uint32_t saved_irq)
+{
+    (void)saved_irq;
+    atomic_store(lock, 0);
+}
+
+#endif //__HOST_HARDWARE_SYNC_H__
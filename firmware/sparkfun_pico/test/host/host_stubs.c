@@ -0,0 +1,53 @@
+// ホストでのテスト用 (pico-sdk の代わり)
+// HOST_SRAM_HEAP_SIZE: リンカの __heap_start .. __heap_end (SRAM ヒープ) の大きさ
+// HOST_PSRAM_SIZE: 0 以外なら PSRAM_LOCATION (0x11000000) に mmap して PSRAM の代わりにする
+#include <stdio.h>
+#include <sys/mman.h>
+#include "hardware/sync.h"
+#include "sfe_psram.h"
+
+#ifndef HOST_SRAM_HEAP_SIZE
+#define HOST_SRAM_HEAP_SIZE (256 * 1024)
+#endif
+#ifndef HOST_PSRAM_SIZE
+#define HOST_PSRAM_SIZE (0)
+#endif
+#define HOST_PSRAM_LOCATION (0x11000000)
+
+#define HOST_STR(x) #x
+#define HOST_XSTR(x) HOST_STR(x)
+
+__asm__(".bss\n"
+        ".balign 64\n"
+        ".globl __heap_start\n"
+        "__heap_start:\n"
+        ".space " HOST_XSTR(HOST_SRAM_HEAP_SIZE) "\n"
+        ".globl __heap_end\n"
+        "__heap_end:\n"
+        ".space 64\n"
+        ".text\n");
+
+_Thread_local uint32_t host_core;
+spin_lock_t host_spin_locks[32];
+
+uint32_t spin_lock_claim_unused(bool required)
+{
+    static uint32_t next = 24; // PICO_SPINLOCK_ID_CLAIM_FREE_FIRST
+    (void)required;
+    return next++;
+}
+
+size_t sfe_setup_psram(uint32_t psram_cs_pin)
+{
+    (void)psram_cs_pin;
+    if (HOST_PSRAM_SIZE == 0)
+        return 0;
+    void *p = mmap((void *)HOST_PSRAM_LOCATION, HOST_PSRAM_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    if (p != (void *)HOST_PSRAM_LOCATION)
+    {
+        printf("host: cannot map the PSRAM at 0x%x\n", HOST_PSRAM_LOCATION);
+        return 0;
+    }
+    return HOST_PSRAM_SIZE;
+}
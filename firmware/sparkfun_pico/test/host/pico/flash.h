@@ -0,0 +1,6 @@
+#ifndef __HOST_PICO_FLASH_H__
+#define __HOST_PICO_FLASH_H__
+
+// ホストでのテスト用 (空). sfe_pico_alloc.c の #include を通すだけ
+
+#endif //__HOST_PICO_FLASH_H__
@@ -0,0 +1,11 @@
+#ifndef __HOST_PICO_STDLIB_H__
+#define __HOST_PICO_STDLIB_H__
+
+// ホストでのテスト用 (pico-sdk の代わり)
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define _u(x) x##u
+
+#endif //__HOST_PICO_STDLIB_H__
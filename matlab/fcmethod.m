@@ -1,11 +1,12 @@
 % 法線から伝達関数を作り、frankot-Chellappaアルゴリズムで深度の復元をする
 % 鏡面反射の場合などの対処はしていません。各自で実装してください
 
-function depths = fcmethod(dx, dy, high_res)
+function depths = fcmethod(dx, dy, high_res, packed)
 arguments
     dx = []
     dy = []
     high_res = false % 高解像度にしたい場合ここをtrueにする(処理時間が長くなる)
+    packed = false % trueにするとdx + i*dyを1回のFFTで変換する(ファームウェアのfcmethod_packed()と同じ)
 end
 
 [M, N] = size(dx); % M,Nは画像のサイズ(行方向,列方向)
@@ -41,8 +42,16 @@ denom = (u .^ 2 + v .^ 2);
 denom(1, 1) = 1; %To avoid division by zero.
 
 % 法線の勾配の2DFFT
-FDX = fft2(dx);
-FDY = fft2(dy);
+if(packed)
+    % 共役対称性で2つの実数場のスペクトルを分離する
+    C = fft2(dx + 1i * dy);
+    Cm = conj(C([1, M:-1:2], [1, N:-1:2])); % conj(C(-k))
+    FDX = (C + Cm) / 2;
+    FDY = (C - Cm) / 2i;
+else
+    FDX = fft2(dx);
+    FDY = fft2(dy);
+end
 
 % fprintf('float FDY[]={');
 % for i = 1:size(FDX, 1)
@@ -3,8 +3,10 @@
 % our original video format
 % frame start: '0xdeadbeef', row_size_in_words(type:uint32,unit is in
 % words(not bytes)) , columb_sizein_words(type:uint32), total blocks per
-% frame(type:uint32)
+% frame(type:uint32), light source Lx, Ly, Lz, k (type:single)
 % next udp packet: '0xbeefbeef', matrix_row_number(uint32), matrix_columb_number(uint32),data_length(uint32),data....
+% (a row wider than 321 values is split into several packets: columb number is the 1st column of the packet,
+%  total blocks = rows x packets per row)
 % next udp packet ...
 % next udp packet ...
 % frame end: '0xdeaddead'
@@ -56,6 +58,8 @@ while (true)
             row_size = dataReceived(2);
             col_size = dataReceived(3);
             blk_size = dataReceived(4);
+            light = typecast(dataReceived(5:8),'single');
+            fprintf('L = [%f %f %f], k = %f\n', light(1), light(2), light(3), light(4));
             break;
         end
 
@@ -63,8 +67,10 @@ while (true)
 
     wordsReceived = 0;
     %rcv = [];
-    if false == frame_initialized
+    % (re)allocate when the frame size changes (ROI / mode change)
+    if false == frame_initialized || any(size(out) ~= double([row_size col_size]))
         out = zeros(row_size,col_size,'single');
+        img = zeros(row_size,col_size,'single');
         frame_initialized = true;
     end
     for i=1:blk_size
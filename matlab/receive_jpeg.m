@@ -0,0 +1,84 @@
+% video receiver via UDP
+% JPEG format (USE_COLOR_IMAGE=1, USE_JPEG_IMAGE=1)
+% frame start: '0xdeadbeef', packets(type:uint32), words_per_packet(type:uint32),
+% packets(type:uint32), frame size in bytes(type:uint32)
+% next udp packet: '0xbeefbeef', packet_number(uint32, from 1), 1(uint32), data_length(uint32, in words),data....
+% next udp packet ...
+% frame end: '0xdeaddead'
+
+clc;
+clear;
+close all;
+
+udpr = dsp.UDPReceiver( ...
+    'LocalIPPort',1234, ...
+    'MessageDataType', 'uint32', ...
+    'MaximumMessageLength',2342);
+% udp setup
+setup(udpr);
+disp('OK');
+frame_start_packet = 0xdeadbeef;
+header_pixel_data = 0xbeefbeef;
+frame_end_packet = 0xdeaddead;
+frame_counter = 0;
+tmp_file = [tempname '.jpg'];
+tStart = tic;
+while (true)
+    % seek header
+    while true
+        dataReceived = udpr();
+        if  false == isempty(dataReceived) && frame_start_packet == dataReceived(1)
+            pkt_num = dataReceived(2);
+            pkt_words = dataReceived(3);
+            frame_bytes = dataReceived(5);
+            break;
+        end
+    end
+
+    out = zeros(1, pkt_num * pkt_words, 'uint32');
+    pkt_received = 0;
+    while pkt_received < pkt_num
+        dataReceived = udpr();
+        if isempty(dataReceived)
+            continue;
+        end
+        if frame_end_packet == dataReceived(1)
+            break;
+        end
+        if header_pixel_data == dataReceived(1)
+            r = dataReceived(2); % packet number
+            sz = dataReceived(4); % data size
+            if (r > 0 && r <= pkt_num && sz > 0)
+                st = (r - 1) * pkt_words + 1;
+                out(st:(st + sz - 1)) = dataReceived(5:5+sz-1);
+                pkt_received = pkt_received + 1;
+            end
+        end
+    end
+    if pkt_received < pkt_num
+        disp('packet lost');
+        continue;
+    end
+
+    %% decode image
+    % byte0 of the frame is bits[7:0] of the 1st word
+    bytes = typecast(out, 'uint8');
+    fid = fopen(tmp_file, 'w');
+    fwrite(fid, bytes(1:frame_bytes));
+    fclose(fid);
+    try
+        imshow(imread(tmp_file));
+        drawnow;
+        frame_counter = frame_counter + 1;
+    catch
+        disp('broken frame');
+    end
+
+    if(frame_counter > 40)
+        tEnd = toc(tStart);
+        fps = frame_counter / tEnd;
+        disp(fps);
+        frame_counter = 0;
+        tStart = tic;
+    end
+end